@@ -25,9 +25,14 @@
 
 #include "vector.hpp"
 #include "matrix.hpp"
+#include <array>
 
 namespace math {
 
+// a 3x4 transform, the orientation columns followed by the position. The
+// members are laid out like a column major matrix<T, 3, 4>, a quarter
+// smaller than the 4x4 form in instance buffers. The orientation may hold
+// scale and shear
 template<typename T>
 struct affine {
     matrix<T, 3, 3> orientation;
@@ -43,20 +48,54 @@ struct affine {
 
     affine(const matrix<T, 3, 3>& rot, const vector<T, 3>& pos) :
       orientation(rot), position(pos) {}
+
+    // the bottom row is assumed to be 0 0 0 1 and never read
+    explicit affine(const matrix<T, 4, 4>& m) :
+      orientation(vector<T, 3>(m.x.x, m.x.y, m.x.z), vector<T, 3>(m.y.x, m.y.y, m.y.z), vector<T, 3>(m.z.x, m.z.y, m.z.z)),
+      position(m.w.x, m.w.y, m.w.z) {}
 };
 
+static_assert(sizeof(affine<float>) == 12 * sizeof(float));
+static_assert(sizeof(affine<double>) == 12 * sizeof(double));
+
+// the 4x4 form with the position in the w column
+template<typename T>
+constexpr auto to_matrix(const affine<T>& aff)
+{
+    const auto& o = aff.orientation;
+    const matrix<T, 4, 4> result(vector<T, 4>(o.x, T(0)), vector<T, 4>(o.y, T(0)), vector<T, 4>(o.z, T(0)), vector<T, 4>(aff.position, T(1)));
+    return result;
+}
+
+template<typename T>
+constexpr auto transform_vector(const affine<T>& aff, const vector<T, 3>& vec)
+{
+    const auto& o = aff.orientation;
+    const auto result = o.x * vec.x + o.y * vec.y + o.z * vec.z;
+    return result;
+}
+
+template<typename T>
+constexpr auto transform_point(const affine<T>& aff, const vector<T, 3>& vec)
+{
+    const auto result = transform_vector(aff, vec) + aff.position;
+    return result;
+}
+
+// homogeneous input, the position is weighted by w
 template<typename T>
 constexpr auto mul(const affine<T>& aff, const vector<T, 4>& vec)
 {
-    const auto rot = mul(aff.orientation, vec.xyz);
+    const auto rot = transform_vector(aff, vector<T, 3>(vec.x, vec.y, vec.z));
     const auto result = rot + aff.position * vec.w;
     return result;
 }
 
+// a three component vector is a direction, w = 0
 template<typename T>
 constexpr auto mul(const affine<T>& aff, const vector<T, 3>& vec)
 {
-    const auto result = mul(aff.orientation, vec);
+    const auto result = transform_vector(aff, vec);
     return result;
 }
 
@@ -68,11 +107,88 @@ constexpr auto mul(const affine<T>& aff, const math::matrix<T, 3, 3>& ori)
     return result;
 }
 
+// the column kernel of mul(affine, affine) on the twelve contiguous
+// elements, result column c is written at z + c * S. The columns of x load
+// as four lane registers that run one element into the next column, only
+// the position stops at three. With S = 3 each store overwrites the spill
+// of the one before. Everything is loaded before the first store so z may
+// alias x or y. Without intrinsics the generic packs would build the
+// position through the stack, the scalar loop is faster there
+template<size_t S, typename T>
+auto mul_affine(const T* x, const T* y, T* z)
+{
+#if defined(LUCMATH_SIMD)
+    if constexpr (simd_backed<T, 4>) {
+        using lane = simd::pack<T, 4>;
+        const auto c0 = lane::load(x), c1 = lane::load(x + 3), c2 = lane::load(x + 6), c3 = lane::load3(x + 9);
+        const auto column = [&](size_t c, const lane& t) {
+            return simd::fmadd(c2, lane(y[c + 2]), simd::fmadd(c1, lane(y[c + 1]), t));
+        };
+        const auto e0 = column(0, c0 * lane(y[0]));
+        const auto e1 = column(3, c0 * lane(y[3]));
+        const auto e2 = column(6, c0 * lane(y[6]));
+        const auto e3 = column(9, simd::fmadd(c0, lane(y[9]), c3));
+        e0.store(z);
+        e1.store(z + S);
+        e2.store(z + 2 * S);
+        if constexpr (S == 3)
+            e3.store3(z + 3 * S);
+        else
+            e3.store(z + 3 * S);
+        return;
+    }
+#endif
+    std::array<T, 12> e;
+    for (size_t c = 0; c < 12; c += 3)
+        for (size_t r = 0; r < 3; r++)
+            e[c + r] = x[r] * y[c] + x[3 + r] * y[c + 1] + x[6 + r] * y[c + 2];
+    for (size_t c = 0; c < 4; c++)
+        for (size_t r = 0; r < 3; r++)
+            z[c * S + r] = c < 3 ? e[c * 3 + r] : e[c * 3 + r] + x[9 + r];
+}
+
+// b applied first, then a, like mul(to_matrix(a), to_matrix(b)). The
+// columns go through whole register stores to a padded block, reading
+// overlapping stores back would stall
+template<typename T>
+auto mul(const affine<T>& a, const affine<T>& b)
+{
+    std::array<T, 16> e;
+    mul_affine<4>(reinterpret_cast<const T*>(&a), reinterpret_cast<const T*>(&b), e.data());
+    const affine<T> result(matrix<T, 3, 3>({ e[0], e[1], e[2] }, { e[4], e[5], e[6] }, { e[8], e[9], e[10] }),
+                           { e[12], e[13], e[14] });
+    return result;
+}
+
+// any invertible orientation, it goes through its adjugate and the
+// position is mapped back through the result
 template<typename T>
 constexpr auto inverse(const affine<T>& aff)
 {
-    const auto inv = inverse(aff.orientation);
-    const affine<T> result(inv, -aff.position);
+    const auto& o = aff.orientation;
+    const auto& p = aff.position;
+    const auto adj = adjugate(o);
+    const auto inv_det = T(1) / (o.x.x * adj.x.x + o.y.x * adj.x.y + o.z.x * adj.x.z);
+    const auto m = [&](size_t c, size_t r) { return adj.columns[c][r] * inv_det; };
+    const affine<T> result(
+      matrix<T, 3, 3>({ m(0, 0), m(0, 1), m(0, 2) }, { m(1, 0), m(1, 1), m(1, 2) }, { m(2, 0), m(2, 1), m(2, 2) }),
+      { -(m(0, 0) * p.x + m(1, 0) * p.y + m(2, 0) * p.z),
+        -(m(0, 1) * p.x + m(1, 1) * p.y + m(2, 1) * p.z),
+        -(m(0, 2) * p.x + m(1, 2) * p.y + m(2, 2) * p.z) });
+    return result;
+}
+
+// rotation and translation only, the orientation is transposed
+template<typename T>
+constexpr auto inverse_rigid(const affine<T>& aff)
+{
+    const auto& o = aff.orientation;
+    const auto& p = aff.position;
+    const affine<T> result(
+      matrix<T, 3, 3>({ o.x.x, o.y.x, o.z.x }, { o.x.y, o.y.y, o.z.y }, { o.x.z, o.y.z, o.z.z }),
+      { -(o.x.x * p.x + o.x.y * p.y + o.x.z * p.z),
+        -(o.y.x * p.x + o.y.y * p.y + o.y.z * p.z),
+        -(o.z.x * p.x + o.z.y * p.y + o.z.z * p.z) });
     return result;
 }
 
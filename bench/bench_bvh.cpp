@@ -0,0 +1,207 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+namespace {
+
+// small triangles scattered through the unit cube, roughly a scanned mesh
+template<typename T>
+auto triangle_soup(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::triangle<T>> result(n);
+    const auto size = T(2) / std::cbrt(T(n));
+    for (auto& tri : result) {
+        const auto center = bench::generator<V>::make();
+        for (auto& v : tri)
+            v = center + bench::generator<V>::make() * size;
+    }
+    return result;
+}
+
+// triangle k spans the corners of [0, 0.5^k]^3, every bounds nests in the
+// one before it and the sah build has no good split to make. Doubles keep
+// a thousand of them apart
+template<typename T>
+auto nested_triangles(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::triangle<T>> result(n);
+    for (size_t k = 0; k < n; k++) {
+        const auto s = std::ldexp(T(1), -int(k));
+        result[k] = math::triangle<T>{ V(s, T(0), T(0)), V(T(0), s, T(0)), V(T(0), T(0), s) };
+    }
+    return result;
+}
+
+template<typename T>
+auto random_rays(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::ray<T, 3>> result(n);
+    for (auto& r : result)
+        r = math::ray<T, 3>{ bench::generator<V>::make() * T(2), math::normalize(bench::generator<V>::make()) };
+    return result;
+}
+
+// bundles of 8 rays leaving one origin within a narrow cone
+template<typename T>
+auto coherent_rays(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::ray<T, 3>> result(n);
+    for (size_t i = 0; i < n; i += 8) {
+        const auto origin = bench::generator<V>::make() * T(2);
+        const auto direction = math::normalize(bench::generator<V>::make());
+        for (size_t k = i; k < std::min(n, i + 8); k++)
+            result[k] = math::ray<T, 3>{ origin, math::normalize(direction + bench::generator<V>::make() * T(.02)) };
+    }
+    return result;
+}
+
+} // namespace
+
+template<typename T>
+static void bvh_build(benchmark::State& state)
+{
+    const auto triangles = triangle_soup<T>(size_t(state.range(0)));
+    for (auto _ : state) {
+        const math::bvh<T> tree(triangles);
+        benchmark::DoNotOptimize(tree.nodes.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void bvh_closest_hit(benchmark::State& state)
+{
+    const auto triangles = triangle_soup<T>(size_t(state.range(0)));
+    const math::bvh<T> tree(triangles);
+    const auto rays = random_rays<T>(size_t(bench::batch_size));
+    for (auto _ : state) {
+        for (const auto& r : rays) {
+            const math::watertight_ray<T> w(r);
+            const auto hit = tree.closest_hit(r, T(0), std::numeric_limits<T>::max(), [&](uint32_t i, T& t) {
+                const auto h = math::intersect(w, triangles[i], T(0), t);
+                if (h)
+                    t = h->t;
+                return h.has_value();
+            });
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * bench::batch_size);
+}
+
+template<typename T>
+static void bvh_any_hit(benchmark::State& state)
+{
+    const auto triangles = triangle_soup<T>(size_t(state.range(0)));
+    const math::bvh<T> tree(triangles);
+    const auto rays = random_rays<T>(size_t(bench::batch_size));
+    for (auto _ : state) {
+        for (const auto& r : rays) {
+            const math::watertight_ray<T> w(r);
+            const auto hit = tree.any_hit(r, T(0), std::numeric_limits<T>::max(), [&](uint32_t i, T& t) {
+                return math::intersect(w, triangles[i], T(0), t).has_value();
+            });
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * bench::batch_size);
+}
+
+template<typename T>
+static void bvh_closest_hit_coherent(benchmark::State& state)
+{
+    const auto triangles = triangle_soup<T>(size_t(state.range(0)));
+    const math::bvh<T> tree(triangles);
+    const auto rays = coherent_rays<T>(size_t(bench::batch_size));
+    for (auto _ : state) {
+        for (const auto& r : rays) {
+            const math::watertight_ray<T> w(r);
+            const auto hit = tree.closest_hit(r, T(0), std::numeric_limits<T>::max(), [&](uint32_t i, T& t) {
+                const auto h = math::intersect(w, triangles[i], T(0), t);
+                if (h)
+                    t = h->t;
+                return h.has_value();
+            });
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * bench::batch_size);
+}
+
+// deep trees traverse within the fixed stack, rays aim at the shared corner
+template<typename T>
+static void bvh_closest_hit_nested(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    const auto triangles = nested_triangles<T>(size_t(state.range(0)));
+    const math::bvh<T> tree(triangles);
+    auto rays = random_rays<T>(size_t(bench::batch_size));
+    for (auto& r : rays)
+        r.d = math::normalize(V(T(.01)) - r.p);
+    for (auto _ : state) {
+        for (const auto& r : rays) {
+            const math::watertight_ray<T> w(r);
+            const auto hit = tree.closest_hit(r, T(0), std::numeric_limits<T>::max(), [&](uint32_t i, T& t) {
+                const auto h = math::intersect(w, triangles[i], T(0), t);
+                if (h)
+                    t = h->t;
+                return h.has_value();
+            });
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * bench::batch_size);
+}
+
+// same rays as bvh_closest_hit_coherent, traced W at a time
+template<typename T, size_t W>
+static void bvh_closest_hit_packet(benchmark::State& state)
+{
+    const auto triangles = triangle_soup<T>(size_t(state.range(0)));
+    const math::bvh<T> tree(triangles);
+    const auto rays = coherent_rays<T>(size_t(bench::batch_size));
+    for (auto _ : state) {
+        for (size_t i = 0; i < rays.size(); i += W) {
+            auto packet = math::ray_packet<T, W>::load(std::span(rays).subspan(i), T(0), std::numeric_limits<T>::max());
+            const auto hit = tree.closest_hit(packet, [&](uint32_t k, const math::ray_packet<T, W>& p) {
+                return math::intersect(p, triangles[k]).t;
+            });
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * bench::batch_size);
+}
+
+BENCHMARK_TEMPLATE(bvh_build, float)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bvh_build, double)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bvh_closest_hit, float)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(bvh_closest_hit, double)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bvh_any_hit, float)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(bvh_closest_hit_nested, double)->Arg(1000);
+BENCHMARK_TEMPLATE(bvh_closest_hit_coherent, float)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bvh_closest_hit_packet, float, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bvh_closest_hit_packet, float, 8)->Arg(1 << 16);
@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include "math.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace bench {
+
+// every case runs once on a single element and once on a batch
+inline constexpr int64_t batch_size = 4096;
+
+inline auto& engine()
+{
+    static std::mt19937 result(1234);
+    return result;
+}
+
+template<typename T>
+struct generator {
+    static auto make()
+    {
+        std::uniform_real_distribution<T> dist(T(0), T(1));
+        const T result = dist(engine());
+        return result;
+    }
+};
+
+template<typename T, size_t N>
+struct generator<math::vector<T, N>> {
+    static auto make()
+    {
+        std::uniform_real_distribution<T> dist(T(-1), T(1));
+        math::vector<T, N> result;
+        for (size_t i = 0; i < N; i++)
+            result[i] = dist(engine());
+        return result;
+    }
+};
+
+template<typename T>
+struct generator<math::quaternion<T>> {
+    static auto make()
+    {
+        const auto v = generator<math::vector<T, 4>>::make();
+        const auto result = math::normalize(math::quaternion<T>(v));
+        return result;
+    }
+};
+
+// diagonally dominant so inverse stays well conditioned
+template<typename T, size_t N>
+struct generator<math::matrix<T, N, N>> {
+    static auto make()
+    {
+        std::uniform_real_distribution<T> dist(T(-1), T(1));
+        math::matrix<T, N, N> result;
+        for (size_t i = 0; i < N * N; i++)
+            result.values[i] = dist(engine());
+        for (size_t i = 0; i < N; i++)
+            result.values[i * N + i] += T(N);
+        return result;
+    }
+};
+
+template<typename T>
+struct generator<math::affine<T>> {
+    static auto make()
+    {
+        const math::affine<T> result(generator<math::matrix<T, 3, 3>>::make(), generator<math::vector<T, 3>>::make());
+        return result;
+    }
+};
+
+template<typename T>
+struct generator<math::dual_quaternion<T>> {
+    static auto make()
+    {
+        const math::dual_quaternion<T> result(generator<math::quaternion<T>>::make(), generator<math::vector<T, 3>>::make());
+        return result;
+    }
+};
+
+template<>
+struct generator<math::dekker> {
+    static auto make()
+    {
+        std::uniform_real_distribution<double> dist(-1e3, 1e3);
+        const math::dekker result(dist(engine()));
+        return result;
+    }
+};
+
+template<typename V>
+auto random_batch(size_t n)
+{
+    std::vector<V> result(n);
+    for (auto& v : result)
+        v = generator<V>::make();
+    return result;
+}
+
+// applies f to n random argument tuples per iteration, n comes from the
+// benchmark argument so the same case covers scalar and batched throughput
+template<typename... A, typename F>
+void run(benchmark::State& state, F f)
+{
+    const auto n = size_t(state.range(0));
+    const auto inputs = std::make_tuple(random_batch<A>(n)...);
+    using R = decltype(f(std::declval<const A&>()...));
+    std::vector<R> out(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++)
+            out[i] = std::apply([&](const auto&... in) { return f(in[i]...); }, inputs);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+} // namespace bench
+
+#define LUCMATH_BENCH(...) BENCHMARK_TEMPLATE(__VA_ARGS__)->Arg(1)->Arg(bench::batch_size)
+
+#endif /* BENCH_COMMON_H */
@@ -0,0 +1,101 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+// dekker is double-double only, the double cases are the plain baseline
+
+template<typename T>
+static void dekker_add(benchmark::State& state)
+{
+    bench::run<T, T>(state, [](const T& a, const T& b) { return a + b; });
+}
+
+template<typename T>
+static void dekker_mul(benchmark::State& state)
+{
+    bench::run<T, T>(state, [](const T& a, const T& b) { return a * b; });
+}
+
+template<typename T>
+static void dekker_div(benchmark::State& state)
+{
+    bench::run<T, T>(state, [](const T& a, const T& b) { return a / b; });
+}
+
+static void dekker_mul12(benchmark::State& state)
+{
+    bench::run<double, double>(state, [](const double& a, const double& b) { return math::dekker_mul12(a, b); });
+}
+
+// both error-free products, the dispatched one above picks fma when it is fast
+static void dekker_mul12_split(benchmark::State& state)
+{
+    bench::run<double, double>(state, [](const double& a, const double& b) { return math::dekker_mul12_split(a, b); });
+}
+
+static void dekker_mul12_fma(benchmark::State& state)
+{
+    bench::run<double, double>(state, [](const double& a, const double& b) { return math::dekker_mul12_fma(a, b); });
+}
+
+// span kernels, items are double-doubles
+template<typename F>
+static void dekker_many(benchmark::State& state, F&& f)
+{
+    const auto a = bench::random_batch<math::dekker>(size_t(state.range(0)));
+    const auto b = bench::random_batch<math::dekker>(size_t(state.range(0)));
+    std::vector<math::dekker> out(a.size());
+    for (auto _ : state) {
+        f(a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+static void dekker_add_many(benchmark::State& state)
+{
+    dekker_many(state, [](const auto& a, const auto& b, auto& out) { math::add_many(a, b, out); });
+}
+
+static void dekker_mul_many(benchmark::State& state)
+{
+    dekker_many(state, [](const auto& a, const auto& b, auto& out) { math::mul_many(a, b, out); });
+}
+
+static void dekker_div_many(benchmark::State& state)
+{
+    dekker_many(state, [](const auto& a, const auto& b, auto& out) { math::div_many(a, b, out); });
+}
+
+LUCMATH_BENCH(dekker_add, double);
+LUCMATH_BENCH(dekker_add, math::dekker);
+LUCMATH_BENCH(dekker_mul, double);
+LUCMATH_BENCH(dekker_mul, math::dekker);
+LUCMATH_BENCH(dekker_div, double);
+LUCMATH_BENCH(dekker_div, math::dekker);
+BENCHMARK(dekker_mul12)->Arg(1)->Arg(bench::batch_size);
+BENCHMARK(dekker_mul12_split)->Arg(1)->Arg(bench::batch_size);
+BENCHMARK(dekker_mul12_fma)->Arg(1)->Arg(bench::batch_size);
+BENCHMARK(dekker_add_many)->Arg(bench::batch_size)->Arg(100000);
+BENCHMARK(dekker_mul_many)->Arg(bench::batch_size)->Arg(100000);
+BENCHMARK(dekker_div_many)->Arg(bench::batch_size)->Arg(100000);
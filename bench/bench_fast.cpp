@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+// inputs in [0, 1) are spread over a few periods for sin and cos and mapped
+// onto [-1, 1] for acos
+
+template<typename T, typename P>
+static void scalar_sin(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return P::sin(x * T(20) - T(10)); });
+}
+
+template<typename T, typename P>
+static void scalar_sincos(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) {
+        const auto [s, c] = P::sincos(x * T(20) - T(10));
+        return s + c;
+    });
+}
+
+template<typename T, typename P>
+static void scalar_acos(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return P::acos(x * T(2) - T(1)); });
+}
+
+template<typename T, typename P>
+static void scalar_atan2(benchmark::State& state)
+{
+    bench::run<T, T>(state, [](const T& y, const T& x) { return P::atan2(y - T(.5), x - T(.5)); });
+}
+
+template<typename T>
+static void scalar_exp_std(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return std::exp(x * T(20) - T(10)); });
+}
+
+template<typename T>
+static void scalar_exp_fast(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return math::fast::exp(x * T(20) - T(10)); });
+}
+
+template<typename T>
+static void scalar_log_std(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return std::log(x + T(1e-3)); });
+}
+
+template<typename T>
+static void scalar_log_fast(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return math::fast::log(x + T(1e-3)); });
+}
+
+template<typename T>
+static void scalar_rsqrt_std(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return T(1) / std::sqrt(x + T(1e-3)); });
+}
+
+template<typename T>
+static void scalar_rsqrt_fast(benchmark::State& state)
+{
+    bench::run<T>(state, [](const T& x) { return math::fast::rsqrt(x + T(1e-3)); });
+}
+
+// the rotation builders with either policy
+template<typename T, typename P>
+static void policy_rotation(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, T>(state, [](const V& axis, const T& angle) { return math::rotation(axis, angle, P{}); });
+}
+
+template<typename T, typename P>
+static void policy_from_euler(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V>(state, [](const V& e) { return math::from_euler(e, math::euler_order::xyz, P{}); });
+}
+
+template<typename T, typename P>
+static void policy_to_euler(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<Q>(state, [](const Q& q) { return math::to_euler(q, math::euler_order::xyz, P{}); });
+}
+
+template<typename T, typename P>
+static void policy_slerp(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<T, Q, Q>(state, [](const T& x, const Q& a, const Q& b) { return math::slerp(x, a, b, P{}); });
+}
+
+// the pack kernels over a whole array at the native width, items are values
+template<typename T>
+static void lanes_sincos(benchmark::State& state)
+{
+    constexpr auto W = math::simd::native_width<T>;
+    using lane = math::simd::pack<T, W>;
+    const auto n = size_t(state.range(0));
+    auto x = bench::random_batch<T>(n);
+    for (auto& v : x)
+        v = v * T(20) - T(10);
+    std::vector<T> s(n), c(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i += W) {
+            const auto [si, ci] = math::fast::sincos(lane::load(x.data() + i));
+            si.store(s.data() + i);
+            ci.store(c.data() + i);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void lanes_atan2(benchmark::State& state)
+{
+    constexpr auto W = math::simd::native_width<T>;
+    using lane = math::simd::pack<T, W>;
+    const auto n = size_t(state.range(0));
+    const auto y = bench::random_batch<T>(n);
+    const auto x = bench::random_batch<T>(n);
+    std::vector<T> out(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i += W) {
+            const auto a = math::fast::atan2(lane::load(y.data() + i) - lane(T(.5)), lane::load(x.data() + i) - lane(T(.5)));
+            a.store(out.data() + i);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+using math::precise_policy;
+using math::fast_policy;
+
+LUCMATH_BENCH(scalar_sin, float, precise_policy);
+LUCMATH_BENCH(scalar_sin, float, fast_policy);
+LUCMATH_BENCH(scalar_sin, double, precise_policy);
+LUCMATH_BENCH(scalar_sin, double, fast_policy);
+LUCMATH_BENCH(scalar_sincos, float, precise_policy);
+LUCMATH_BENCH(scalar_sincos, float, fast_policy);
+LUCMATH_BENCH(scalar_sincos, double, precise_policy);
+LUCMATH_BENCH(scalar_sincos, double, fast_policy);
+LUCMATH_BENCH(scalar_acos, float, precise_policy);
+LUCMATH_BENCH(scalar_acos, float, fast_policy);
+LUCMATH_BENCH(scalar_acos, double, precise_policy);
+LUCMATH_BENCH(scalar_acos, double, fast_policy);
+LUCMATH_BENCH(scalar_atan2, float, precise_policy);
+LUCMATH_BENCH(scalar_atan2, float, fast_policy);
+LUCMATH_BENCH(scalar_atan2, double, precise_policy);
+LUCMATH_BENCH(scalar_atan2, double, fast_policy);
+LUCMATH_BENCH(scalar_exp_std, float);
+LUCMATH_BENCH(scalar_exp_fast, float);
+LUCMATH_BENCH(scalar_log_std, float);
+LUCMATH_BENCH(scalar_log_fast, float);
+LUCMATH_BENCH(scalar_rsqrt_std, float);
+LUCMATH_BENCH(scalar_rsqrt_fast, float);
+LUCMATH_BENCH(policy_rotation, float, precise_policy);
+LUCMATH_BENCH(policy_rotation, float, fast_policy);
+LUCMATH_BENCH(policy_from_euler, float, precise_policy);
+LUCMATH_BENCH(policy_from_euler, float, fast_policy);
+LUCMATH_BENCH(policy_to_euler, float, precise_policy);
+LUCMATH_BENCH(policy_to_euler, float, fast_policy);
+LUCMATH_BENCH(policy_slerp, float, precise_policy);
+LUCMATH_BENCH(policy_slerp, float, fast_policy);
+BENCHMARK_TEMPLATE(lanes_sincos, float)->Arg(100000);
+BENCHMARK_TEMPLATE(lanes_sincos, double)->Arg(100000);
+BENCHMARK_TEMPLATE(lanes_atan2, float)->Arg(100000);
+BENCHMARK_TEMPLATE(lanes_atan2, double)->Arg(100000);
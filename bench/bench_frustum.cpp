@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+namespace {
+
+// instance bounds scattered around a camera at the origin looking down -z,
+// roughly a tenth of them end up inside the frustum
+template<typename T>
+auto scene(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::bounds<T, 3>> result(n);
+    for (auto& b : result) {
+        const auto c = bench::generator<V>::make() * T(120);
+        b = math::bounds<T, 3>(c, c + (bench::generator<V>::make() + T(1)) * T(2));
+    }
+    return result;
+}
+
+template<typename T>
+auto camera()
+{
+    using V = math::vector<T, 3>;
+    const auto view = math::look_at(V(0), V(0, 0, -1), V(0, 1, 0));
+    const math::frustum<T> result(math::mul(math::perspective(T(1), T(1.5), T(.1), T(100)), math::transpose(view)));
+    return result;
+}
+
+} // namespace
+
+template<typename T>
+static void frustum_intersects(benchmark::State& state)
+{
+    const auto f = camera<T>();
+    const auto boxes = scene<T>(size_t(state.range(0)));
+    for (auto _ : state) {
+        size_t visible = 0;
+        for (const auto& b : boxes)
+            visible += f.intersects(b);
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void frustum_cull_bits(benchmark::State& state)
+{
+    const auto f = camera<T>();
+    const auto boxes = scene<T>(size_t(state.range(0)));
+    std::vector<uint64_t> visible((boxes.size() + 63) / 64);
+    for (auto _ : state) {
+        f.cull(boxes, visible);
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void frustum_cull_indices(benchmark::State& state)
+{
+    const auto f = camera<T>();
+    const auto boxes = scene<T>(size_t(state.range(0)));
+    std::vector<uint32_t> visible(boxes.size());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(f.cull(boxes, std::span(visible)));
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(frustum_intersects, float)->Arg(1 << 14)->Arg(500000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(frustum_cull_bits, float)->Arg(1 << 14)->Arg(500000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(frustum_cull_bits, double)->Arg(1 << 14)->Arg(500000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(frustum_cull_indices, float)->Arg(1 << 14)->Arg(500000)->Unit(benchmark::kMicrosecond);
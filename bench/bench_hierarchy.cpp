@@ -0,0 +1,87 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+// sixteen roots over a balanced tree with eight children per node, most
+// nodes are leaves like the meshes under a scene graph
+template<typename T>
+static auto make_hierarchy(size_t n)
+{
+    math::hierarchy<T> result;
+    for (size_t i = 0; i < n; i++) {
+        const auto parent = i < 16 ? result.root : uint32_t((i - 16) / 8);
+        result.add(parent, bench::generator<math::matrix<T, 4, 4>>::make());
+    }
+    result.update();
+    return result;
+}
+
+// reference: every world recomputed in node order
+template<typename T>
+static void hierarchy_recompute(benchmark::State& state)
+{
+    auto h = make_hierarchy<T>(size_t(state.range(0)));
+    for (auto _ : state) {
+        for (size_t i = 0; i < h.size(); i++) {
+            const auto p = h.parents[i];
+            h.worlds[i] = p == h.root ? h.locals[i] : math::mul(h.worlds[p], h.locals[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void hierarchy_update_all(benchmark::State& state)
+{
+    auto h = make_hierarchy<T>(size_t(state.range(0)));
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < 16; i++)
+            h.set_local(i, h.locals[i]);
+        h.update();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+// one percent of the nodes change per frame
+template<typename T>
+static void hierarchy_update_sparse(benchmark::State& state)
+{
+    const auto n = size_t(state.range(0));
+    auto h = make_hierarchy<T>(n);
+    std::vector<uint32_t> changed(n / 100);
+    for (auto& i : changed)
+        i = uint32_t(bench::engine()() % n);
+    for (auto _ : state) {
+        for (const auto i : changed)
+            h.set_local(i, h.locals[i]);
+        h.update();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(hierarchy_recompute, float)->Arg(bench::batch_size)->Arg(200000);
+BENCHMARK_TEMPLATE(hierarchy_update_all, float)->Arg(bench::batch_size)->Arg(200000);
+BENCHMARK_TEMPLATE(hierarchy_update_sparse, float)->Arg(bench::batch_size)->Arg(200000);
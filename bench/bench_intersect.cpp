@@ -0,0 +1,141 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+namespace {
+
+template<typename T>
+auto random_ray()
+{
+    using V = math::vector<T, 3>;
+    const math::ray<T, 3> result{ bench::generator<V>::make() * T(2), math::normalize(bench::generator<V>::make()) };
+    return result;
+}
+
+template<typename T>
+auto random_boxes(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::bounds<T, 3>> result(n);
+    for (auto& b : result) {
+        const auto c = bench::generator<V>::make();
+        b = math::bounds<T, 3>(c, c + bench::generator<V>::make() * T(.25));
+    }
+    return result;
+}
+
+template<typename T>
+auto random_triangles(size_t n)
+{
+    using V = math::vector<T, 3>;
+    std::vector<math::triangle<T>> result(n);
+    for (auto& tri : result) {
+        const auto c = bench::generator<V>::make();
+        for (auto& v : tri)
+            v = c + bench::generator<V>::make() * T(.25);
+    }
+    return result;
+}
+
+} // namespace
+
+// one ray against a batch of boxes, items are ray-box tests
+template<typename T>
+static void intersect_bounds(benchmark::State& state)
+{
+    const auto r = random_ray<T>();
+    const auto inv = math::inverse_direction(r);
+    const auto boxes = random_boxes<T>(size_t(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& b : boxes)
+            benchmark::DoNotOptimize(math::intersect(r, inv, b, T(0), T(10)));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T, size_t W>
+static void intersect_bounds_packet(benchmark::State& state)
+{
+    const auto r = random_ray<T>();
+    const auto inv = math::inverse_direction(r);
+    const auto boxes = random_boxes<T>(size_t(state.range(0)));
+    std::vector<math::bounds_soa<T, W>> packets;
+    for (size_t i = 0; i < boxes.size(); i += W)
+        packets.push_back(math::bounds_soa<T, W>::load(std::span(boxes).subspan(i)));
+    for (auto _ : state) {
+        for (const auto& p : packets)
+            benchmark::DoNotOptimize(math::intersect(r, inv, p, T(0), T(10)));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void intersect_triangle(benchmark::State& state)
+{
+    const math::watertight_ray<T> r(random_ray<T>());
+    const auto triangles = random_triangles<T>(size_t(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& tri : triangles)
+            benchmark::DoNotOptimize(math::intersect(r, tri, T(0), T(10)));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T, size_t W>
+static void intersect_triangle_packet(benchmark::State& state)
+{
+    const math::watertight_ray<T> r(random_ray<T>());
+    const auto triangles = random_triangles<T>(size_t(state.range(0)));
+    std::vector<math::triangle_soa<T, W>> packets;
+    for (size_t i = 0; i < triangles.size(); i += W)
+        packets.push_back(math::triangle_soa<T, W>::load(std::span(triangles).subspan(i)));
+    for (auto _ : state) {
+        for (const auto& p : packets)
+            benchmark::DoNotOptimize(math::intersect(r, p, T(0), T(10)));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void intersect_plane(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    const auto r = random_ray<T>();
+    std::vector<math::plane<T>> planes(size_t(state.range(0)));
+    for (auto& p : planes)
+        p = math::plane<T>(bench::generator<V>::make(), math::normalize(bench::generator<V>::make()));
+    for (auto _ : state) {
+        for (const auto& p : planes)
+            benchmark::DoNotOptimize(math::intersect(r, p, T(0), T(10)));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+LUCMATH_BENCH(intersect_bounds, float);
+LUCMATH_BENCH(intersect_bounds_packet, float, 4);
+LUCMATH_BENCH(intersect_bounds_packet, float, 8);
+LUCMATH_BENCH(intersect_triangle, float);
+LUCMATH_BENCH(intersect_triangle, double);
+LUCMATH_BENCH(intersect_triangle_packet, float, 4);
+LUCMATH_BENCH(intersect_triangle_packet, float, 8);
+LUCMATH_BENCH(intersect_plane, float);
@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+template<typename T, size_t N>
+static void matrix_mul_vector(benchmark::State& state)
+{
+    using V = math::vector<T, N>;
+    using M = math::matrix<T, N, N>;
+    bench::run<V, M>(state, [](const V& v, const M& m) { return math::mul(v, m); });
+}
+
+template<typename T, size_t N>
+static void matrix_mul_matrix(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M, M>(state, [](const M& a, const M& b) { return math::mul(a, b); });
+}
+
+template<typename T, size_t N>
+static void matrix_transpose(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M>(state, [](const M& m) { return math::transpose(m); });
+}
+
+template<typename T, size_t N>
+static void matrix_determinant(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M>(state, [](const M& m) { return math::determinant(m); });
+}
+
+template<typename T, size_t N>
+static void matrix_inverse(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M>(state, [](const M& m) { return math::inverse(m); });
+}
+
+// the closed forms only read the transform part, random inputs time the
+// same work as real transforms would
+template<typename T, size_t N>
+static void matrix_inverse_affine(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M>(state, [](const M& m) { return math::inverse_affine(m); });
+}
+
+template<typename T, size_t N>
+static void matrix_inverse_rigid(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M>(state, [](const M& m) { return math::inverse_rigid(m); });
+}
+
+template<typename T, size_t N>
+static void matrix_inverse_orthonormal(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    bench::run<M>(state, [](const M& m) { return math::inverse_orthonormal(m); });
+}
+
+LUCMATH_BENCH(matrix_mul_vector, float, 3);
+LUCMATH_BENCH(matrix_mul_vector, float, 4);
+LUCMATH_BENCH(matrix_mul_vector, double, 3);
+LUCMATH_BENCH(matrix_mul_vector, double, 4);
+LUCMATH_BENCH(matrix_mul_matrix, float, 3);
+LUCMATH_BENCH(matrix_mul_matrix, float, 4);
+LUCMATH_BENCH(matrix_mul_matrix, double, 3);
+LUCMATH_BENCH(matrix_mul_matrix, double, 4);
+LUCMATH_BENCH(matrix_transpose, float, 4);
+LUCMATH_BENCH(matrix_transpose, double, 4);
+LUCMATH_BENCH(matrix_determinant, float, 3);
+LUCMATH_BENCH(matrix_determinant, float, 4);
+LUCMATH_BENCH(matrix_determinant, double, 3);
+LUCMATH_BENCH(matrix_determinant, double, 4);
+LUCMATH_BENCH(matrix_inverse, float, 3);
+LUCMATH_BENCH(matrix_inverse, float, 4);
+LUCMATH_BENCH(matrix_inverse, double, 3);
+LUCMATH_BENCH(matrix_inverse, double, 4);
+LUCMATH_BENCH(matrix_inverse_affine, float, 3);
+LUCMATH_BENCH(matrix_inverse_affine, float, 4);
+LUCMATH_BENCH(matrix_inverse_affine, double, 4);
+LUCMATH_BENCH(matrix_inverse_rigid, float, 3);
+LUCMATH_BENCH(matrix_inverse_rigid, float, 4);
+LUCMATH_BENCH(matrix_inverse_rigid, double, 4);
+LUCMATH_BENCH(matrix_inverse_orthonormal, float, 4);
+LUCMATH_BENCH(matrix_inverse_orthonormal, double, 4);
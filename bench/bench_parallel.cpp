@@ -0,0 +1,110 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "bench_common.hpp"
+
+// the serial kernels against their thread pool versions, the ten million
+// point case is the size the pool is meant to scale on
+
+template<typename T>
+static void bounds_serial(benchmark::State& state)
+{
+    const auto points = bench::random_batch<math::vector<T, 3>>(size_t(state.range(0)));
+    for (auto _ : state) {
+        math::bounds<T, 3> b;
+        for (const auto& p : points)
+            b.extend(p);
+        benchmark::DoNotOptimize(b);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void bounds_parallel(benchmark::State& state)
+{
+    const auto points = bench::random_batch<math::vector<T, 3>>(size_t(state.range(0)));
+    for (auto _ : state) {
+        const auto b = math::parallel::bounds_of<T, 3>(points);
+        benchmark::DoNotOptimize(b);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void transform_points_serial(benchmark::State& state)
+{
+    const auto m = bench::generator<math::matrix<T, 4, 4>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(size_t(state.range(0)));
+    std::vector<math::vector<T, 3>> out(in.size());
+    for (auto _ : state) {
+        math::transform_points<T>(m, in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void transform_points_parallel(benchmark::State& state)
+{
+    const auto m = bench::generator<math::matrix<T, 4, 4>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(size_t(state.range(0)));
+    std::vector<math::vector<T, 3>> out(in.size());
+    for (auto _ : state) {
+        math::parallel::transform_points<T>(m, in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void mul_many_serial(benchmark::State& state)
+{
+    const auto a = bench::random_batch<math::matrix<T, 4, 4>>(size_t(state.range(0)));
+    const auto b = bench::random_batch<math::matrix<T, 4, 4>>(size_t(state.range(0)));
+    std::vector<math::matrix<T, 4, 4>> out(a.size());
+    for (auto _ : state) {
+        math::mul_many<T>(a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void mul_many_parallel(benchmark::State& state)
+{
+    const auto a = bench::random_batch<math::matrix<T, 4, 4>>(size_t(state.range(0)));
+    const auto b = bench::random_batch<math::matrix<T, 4, 4>>(size_t(state.range(0)));
+    std::vector<math::matrix<T, 4, 4>> out(a.size());
+    for (auto _ : state) {
+        math::parallel::mul_many<T>(a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(bounds_serial, float)->Arg(bench::batch_size)->Arg(10000000);
+BENCHMARK_TEMPLATE(bounds_parallel, float)->Arg(bench::batch_size)->Arg(10000000);
+BENCHMARK_TEMPLATE(transform_points_serial, float)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(transform_points_parallel, float)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(mul_many_serial, float)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(mul_many_parallel, float)->Arg(1 << 18);
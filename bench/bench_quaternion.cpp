@@ -0,0 +1,205 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+template<typename T>
+static void quaternion_mul(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<Q, Q>(state, [](const Q& a, const Q& b) { return a * b; });
+}
+
+template<typename T>
+static void quaternion_normalize(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<Q>(state, [](const Q& q) { return math::normalize(q); });
+}
+
+template<typename T>
+static void quaternion_slerp(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<T, Q, Q>(state, [](const T& x, const Q& a, const Q& b) { return math::slerp(x, a, b); });
+}
+
+template<typename T>
+static void quaternion_rotation4(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<Q>(state, [](const Q& q) { return math::rotation4(q); });
+}
+
+template<typename T>
+static void quaternion_from_euler(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V>(state, [](const V& e) { return math::from_euler(e); });
+}
+
+template<typename T>
+static void quaternion_to_euler(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    bench::run<Q>(state, [](const Q& q) { return math::to_euler(q); });
+}
+
+// span kernels over a skeleton worth of bones, items are bones
+template<typename T>
+static void quaternion_mul_many(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    const auto a = bench::random_batch<Q>(size_t(state.range(0)));
+    const auto b = bench::random_batch<Q>(size_t(state.range(0)));
+    std::vector<Q> out(a.size());
+    for (auto _ : state) {
+        math::mul_many<T>(a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void quaternion_normalize_many(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    const auto q = bench::random_batch<Q>(size_t(state.range(0)));
+    std::vector<Q> out(q.size());
+    for (auto _ : state) {
+        math::normalize_many<T>(q, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void quaternion_slerp_many(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    const auto x = bench::random_batch<T>(size_t(state.range(0)));
+    const auto a = bench::random_batch<Q>(size_t(state.range(0)));
+    const auto b = bench::random_batch<Q>(size_t(state.range(0)));
+    std::vector<Q> out(a.size());
+    for (auto _ : state) {
+        math::slerp_many<T>(x, a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void quaternion_rotate_many(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    using V = math::vector<T, 3>;
+    const auto q = bench::random_batch<Q>(size_t(state.range(0)));
+    const auto v = bench::random_batch<V>(size_t(state.range(0)));
+    std::vector<V> out(v.size());
+    for (auto _ : state) {
+        math::rotate_many<T>(q, v, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+// a rig worth of points under one root rotation
+template<typename T>
+static void quaternion_rotate_many_one(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    using V = math::vector<T, 3>;
+    const auto q = math::normalize(bench::random_batch<Q>(1).front());
+    const auto v = bench::random_batch<V>(size_t(state.range(0)));
+    std::vector<V> out(v.size());
+    for (auto _ : state) {
+        math::rotate_many<T>(q, v, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+// a clip worth of authored rotations, items are triples
+template<typename T>
+static void quaternion_from_euler_many(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    using Q = math::quaternion<T>;
+    const auto e = bench::random_batch<V>(size_t(state.range(0)));
+    std::vector<Q> out(e.size());
+    for (auto _ : state) {
+        math::from_euler_many<T>(e, out, math::euler_order::zxy);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void quaternion_to_euler_many(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    using V = math::vector<T, 3>;
+    const auto q = bench::random_batch<Q>(size_t(state.range(0)));
+    std::vector<V> out(q.size());
+    for (auto _ : state) {
+        math::to_euler_many<T>(q, out, math::euler_order::zxy);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void quaternion_rotate(benchmark::State& state)
+{
+    using Q = math::quaternion<T>;
+    using V = math::vector<T, 3>;
+    bench::run<V, Q>(state, [](const V& v, const Q& q) { return math::rotate(v, q); });
+}
+
+LUCMATH_BENCH(quaternion_mul, float);
+LUCMATH_BENCH(quaternion_mul, double);
+LUCMATH_BENCH(quaternion_normalize, float);
+LUCMATH_BENCH(quaternion_normalize, double);
+LUCMATH_BENCH(quaternion_slerp, float);
+LUCMATH_BENCH(quaternion_slerp, double);
+LUCMATH_BENCH(quaternion_rotation4, float);
+LUCMATH_BENCH(quaternion_rotation4, double);
+LUCMATH_BENCH(quaternion_from_euler, float);
+LUCMATH_BENCH(quaternion_from_euler, double);
+LUCMATH_BENCH(quaternion_to_euler, float);
+LUCMATH_BENCH(quaternion_to_euler, double);
+LUCMATH_BENCH(quaternion_rotate, float);
+LUCMATH_BENCH(quaternion_rotate, double);
+BENCHMARK_TEMPLATE(quaternion_mul_many, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_mul_many, double)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_normalize_many, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_normalize_many, double)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_slerp_many, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_slerp_many, double)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_rotate_many, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_rotate_many, double)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_rotate_many_one, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_rotate_many_one, double)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_from_euler_many, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_from_euler_many, double)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_to_euler_many, float)->Arg(100000);
+BENCHMARK_TEMPLATE(quaternion_to_euler_many, double)->Arg(100000);
@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "bench_common.hpp"
+
+// a character sized palette with four influences per vertex
+inline constexpr size_t bone_count = 64;
+
+template<typename T>
+struct mesh {
+    std::vector<math::dual_quaternion<T>> bones;
+    std::vector<math::vector<T, 3>> positions;
+    std::vector<std::array<uint16_t, 4>> indices;
+    std::vector<math::vector<T, 4>> weights;
+    std::vector<math::vector<T, 3>> out;
+
+    explicit mesh(size_t n) :
+      bones(bench::random_batch<math::dual_quaternion<T>>(bone_count)),
+      positions(bench::random_batch<math::vector<T, 3>>(n)),
+      indices(n), weights(n), out(n)
+    {
+        std::uniform_real_distribution<T> dist(T(.01), T(1));
+        for (size_t i = 0; i < n; i++) {
+            for (auto& index : indices[i])
+                index = uint16_t(bench::engine()() % bone_count);
+            const math::vector<T, 4> w(dist(bench::engine()), dist(bench::engine()), dist(bench::engine()), dist(bench::engine()));
+            weights[i] = w / (w.x + w.y + w.z + w.w);
+        }
+    }
+};
+
+// reference: the bones expanded to 4x4 and the matrices blended per vertex
+template<typename T>
+static void skin_matrix_palette(benchmark::State& state)
+{
+    mesh<T> m(size_t(state.range(0)));
+    std::vector<math::matrix<T, 4, 4>> palette;
+    for (const auto& bone : m.bones)
+        palette.push_back(math::to_matrix(bone));
+    for (auto _ : state) {
+        for (size_t i = 0; i < m.positions.size(); i++) {
+            const auto& index = m.indices[i];
+            const auto& weight = m.weights[i];
+            math::matrix<T, 4, 4> blend;
+            for (size_t c = 0; c < 16; c++)
+                blend.values[c] = T(0);
+            for (size_t k = 0; k < 4; k++)
+                for (size_t c = 0; c < 16; c++)
+                    blend.values[c] += palette[index[k]].values[c] * weight[k];
+            const auto p = math::mul(math::vector<T, 4>(m.positions[i], T(1)), blend);
+            m.out[i] = math::vector<T, 3>(p.x, p.y, p.z);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template<typename T>
+static void skin_dual_quaternion(benchmark::State& state)
+{
+    mesh<T> m(size_t(state.range(0)));
+    for (auto _ : state) {
+        math::skin_many<T>(m.bones, m.positions, m.indices, m.weights, m.out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(skin_matrix_palette, float)->Arg(bench::batch_size)->Arg(100000);
+BENCHMARK_TEMPLATE(skin_dual_quaternion, float)->Arg(bench::batch_size)->Arg(100000);
@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace {
+
+// products that cancel in pairs over forty binary orders of magnitude plus
+// one that does not, the exact dot product is 1/3 rounded once. Plain
+// summation loses every digit, twice the precision keeps most of them
+struct cancelling {
+    explicit cancelling(size_t n)
+    {
+        std::uniform_real_distribution<double> dist(-1, 1);
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            const auto x = std::ldexp(dist(bench::engine()), int(dist(bench::engine()) * 20));
+            const auto y = std::ldexp(dist(bench::engine()), int(dist(bench::engine()) * 20));
+            a.insert(a.end(), { x, x });
+            b.insert(b.end(), { y, -y });
+        }
+        a.push_back(1);
+        b.push_back(1. / 3);
+        std::vector<size_t> order(a.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::shuffle(order.begin(), order.end(), bench::engine());
+        for (const auto& i : order) {
+            products.push_back(a[i] * b[i]);
+            x.push_back(a[i]);
+            y.push_back(b[i]);
+        }
+    }
+
+    std::vector<double> a, b, x, y, products;
+};
+
+// relative error against the exact 1/3
+template<typename F>
+void run(benchmark::State& state, F f)
+{
+    const cancelling data(size_t(state.range(0)));
+    double result = 0;
+    for (auto _ : state) {
+        result = f(data);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    state.counters["error"] = std::abs(result * 3 - 1);
+}
+
+} // namespace
+
+static void sum_plain(benchmark::State& state)
+{
+    run(state, [](const auto& d) {
+        double result = 0;
+        for (const auto& p : d.products)
+            result += p;
+        return result;
+    });
+}
+
+static void sum_sum2(benchmark::State& state)
+{
+    run(state, [](const auto& d) { return math::sum2(std::span<const double>(d.products)); });
+}
+
+static void sum_sumk3(benchmark::State& state)
+{
+    run(state, [](const auto& d) { return math::sumk<3>(std::span<const double>(d.products)); });
+}
+
+static void sum_dekker(benchmark::State& state)
+{
+    run(state, [](const auto& d) {
+        math::dekker result(0., 0.);
+        for (const auto& p : d.products)
+            result = result + math::dekker(p, 0.);
+        return result.d();
+    });
+}
+
+static void dot_plain(benchmark::State& state)
+{
+    run(state, [](const auto& d) {
+        double result = 0;
+        for (size_t i = 0; i < d.x.size(); i++)
+            result += d.x[i] * d.y[i];
+        return result;
+    });
+}
+
+static void dot_dot2(benchmark::State& state)
+{
+    run(state, [](const auto& d) { return math::dot2(std::span<const double>(d.x), std::span<const double>(d.y)); });
+}
+
+static void dot_dotk3(benchmark::State& state)
+{
+    run(state, [](const auto& d) { return math::dotk<3>(std::span<const double>(d.x), std::span<const double>(d.y)); });
+}
+
+static void dot_dekker(benchmark::State& state)
+{
+    run(state, [](const auto& d) {
+        math::dekker result(0., 0.);
+        for (size_t i = 0; i < d.x.size(); i++)
+            result = result + math::dekker(d.x[i], 0.) * math::dekker(d.y[i], 0.);
+        return result.d();
+    });
+}
+
+// the long span takes the std::async path where there are several cores
+BENCHMARK(sum_plain)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(sum_sum2)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(sum_sumk3)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(sum_dekker)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(dot_plain)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(dot_dot2)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(dot_dotk3)->Arg(bench::batch_size)->Arg(1 << 20);
+BENCHMARK(dot_dekker)->Arg(bench::batch_size)->Arg(1 << 20);
@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+// reference for the span kernels: one mul(vector, matrix) per element
+template<typename T>
+static void transform_points_loop(benchmark::State& state)
+{
+    const auto n = size_t(state.range(0));
+    const auto m = bench::generator<math::matrix<T, 4, 4>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(n);
+    std::vector<math::vector<T, 3>> out(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            const auto h = math::mul(math::vector<T, 4>(in[i], T(1)), m);
+            out[i] = math::vector<T, 3>(h.x / h.w, h.y / h.w, h.z / h.w);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void transform_points_span(benchmark::State& state)
+{
+    const auto n = size_t(state.range(0));
+    const auto m = bench::generator<math::matrix<T, 4, 4>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(n);
+    std::vector<math::vector<T, 3>> out(n);
+    for (auto _ : state) {
+        math::transform_points(m, in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void transform_vectors_span(benchmark::State& state)
+{
+    const auto n = size_t(state.range(0));
+    const auto m = bench::generator<math::matrix<T, 4, 4>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(n);
+    std::vector<math::vector<T, 3>> out(n);
+    for (auto _ : state) {
+        math::transform_vectors(m, in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void transform_normals_span(benchmark::State& state)
+{
+    const auto n = size_t(state.range(0));
+    const auto m = bench::generator<math::matrix<T, 4, 4>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(n);
+    std::vector<math::vector<T, 3>> out(n);
+    for (auto _ : state) {
+        math::transform_normals(m, in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void transform_points_affine(benchmark::State& state)
+{
+    const auto n = size_t(state.range(0));
+    const auto a = bench::generator<math::affine<T>>::make();
+    const auto in = bench::random_batch<math::vector<T, 3>>(n);
+    std::vector<math::vector<T, 3>> out(n);
+    for (auto _ : state) {
+        math::transform_points(a, in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void affine_mul_many(benchmark::State& state)
+{
+    using A = math::affine<T>;
+    const auto n = size_t(state.range(0));
+    const auto a = bench::random_batch<A>(n);
+    const auto b = bench::random_batch<A>(n);
+    std::vector<A> out(n);
+    for (auto _ : state) {
+        math::mul_many<T>(a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T>
+static void affine_inverse_many(benchmark::State& state)
+{
+    using A = math::affine<T>;
+    const auto n = size_t(state.range(0));
+    const auto in = bench::random_batch<A>(n);
+    std::vector<A> out(n);
+    for (auto _ : state) {
+        math::inverse_many<T>(in, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template<typename T, size_t N>
+static void matrix_mul_many(benchmark::State& state)
+{
+    using M = math::matrix<T, N, N>;
+    const auto n = size_t(state.range(0));
+    const auto a = bench::random_batch<M>(n);
+    const auto b = bench::random_batch<M>(n);
+    std::vector<M> out(n);
+    for (auto _ : state) {
+        math::mul_many<T>(a, b, out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+LUCMATH_BENCH(transform_points_loop, float);
+LUCMATH_BENCH(transform_points_loop, double);
+LUCMATH_BENCH(transform_points_span, float);
+LUCMATH_BENCH(transform_points_span, double);
+LUCMATH_BENCH(transform_vectors_span, float);
+LUCMATH_BENCH(transform_vectors_span, double);
+LUCMATH_BENCH(transform_normals_span, float);
+LUCMATH_BENCH(transform_normals_span, double);
+LUCMATH_BENCH(matrix_mul_many, float, 3);
+LUCMATH_BENCH(matrix_mul_many, float, 4);
+LUCMATH_BENCH(matrix_mul_many, double, 4);
+LUCMATH_BENCH(transform_points_affine, float);
+LUCMATH_BENCH(transform_points_affine, double);
+LUCMATH_BENCH(affine_mul_many, float);
+LUCMATH_BENCH(affine_mul_many, double);
+LUCMATH_BENCH(affine_inverse_many, float);
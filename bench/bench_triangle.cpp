@@ -0,0 +1,60 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+template<typename T>
+static void triangle_center(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, V, V>(state, [](const V& a, const V& b, const V& c) { return math::triangle_center(a, b, c); });
+}
+
+template<typename T>
+static void triangle_normal(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, V, V>(state, [](const V& a, const V& b, const V& c) { return math::triangle_normal(a, b, c); });
+}
+
+template<typename T>
+static void triangle_area(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, V, V>(state, [](const V& a, const V& b, const V& c) { return math::triangle_area(a, b, c); });
+}
+
+template<typename T>
+static void triangle_signed_volume(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, V, V>(state, [](const V& a, const V& b, const V& c) { return math::triangle_signed_volume(a, b, c); });
+}
+
+LUCMATH_BENCH(triangle_center, float);
+LUCMATH_BENCH(triangle_center, double);
+LUCMATH_BENCH(triangle_normal, float);
+LUCMATH_BENCH(triangle_normal, double);
+LUCMATH_BENCH(triangle_area, float);
+LUCMATH_BENCH(triangle_area, double);
+LUCMATH_BENCH(triangle_signed_volume, float);
+LUCMATH_BENCH(triangle_signed_volume, double);
@@ -0,0 +1,87 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+template<typename V>
+static void utils_min(benchmark::State& state)
+{
+    bench::run<V, V>(state, [](const V& a, const V& b) { return math::min(a, b); });
+}
+
+template<typename V>
+static void utils_lerp(benchmark::State& state)
+{
+    using T = std::remove_cvref_t<decltype(V{}[0])>;
+    bench::run<T, V, V>(state, [](const T& x, const V& a, const V& b) { return math::lerp(x, a, b); });
+}
+
+template<typename V>
+static void utils_saturate(benchmark::State& state)
+{
+    bench::run<V>(state, [](const V& v) { return math::saturate(v); });
+}
+
+template<typename T>
+static void utils_reflect(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, V>(state, [](const V& w, const V& n) { return math::reflect(w, n); });
+}
+
+template<typename T>
+static void utils_rotate(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    using Q = math::quaternion<T>;
+    bench::run<V, Q>(state, [](const V& v, const Q& q) { return math::rotate(v, q); });
+}
+
+template<typename T>
+static void utils_vector_angle(benchmark::State& state)
+{
+    using V = math::vector<T, 3>;
+    bench::run<V, V>(state, [](const V& a, const V& b) { return math::vector_angle(a, b); });
+}
+
+// rotate_axis_angle is float only
+static void utils_rotate_axis_angle(benchmark::State& state)
+{
+    using V = math::float3;
+    bench::run<V, V, float>(state, [](const V& v, const V& axis, const float& angle) { return math::rotate_axis_angle(v, axis, angle); });
+}
+
+LUCMATH_BENCH(utils_min, math::float3);
+LUCMATH_BENCH(utils_min, math::float4);
+LUCMATH_BENCH(utils_min, math::double3);
+LUCMATH_BENCH(utils_min, math::double4);
+LUCMATH_BENCH(utils_lerp, math::float3);
+LUCMATH_BENCH(utils_lerp, math::double3);
+LUCMATH_BENCH(utils_saturate, math::float3);
+LUCMATH_BENCH(utils_saturate, math::double3);
+LUCMATH_BENCH(utils_reflect, float);
+LUCMATH_BENCH(utils_reflect, double);
+LUCMATH_BENCH(utils_rotate, float);
+LUCMATH_BENCH(utils_rotate, double);
+LUCMATH_BENCH(utils_vector_angle, float);
+LUCMATH_BENCH(utils_vector_angle, double);
+BENCHMARK(utils_rotate_axis_angle)->Arg(1)->Arg(bench::batch_size);
@@ -0,0 +1,170 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bench_common.hpp"
+
+// embedding sized rows, the same length as the vector<float, 256> cases
+template<typename T>
+struct bench::generator<math::dynvector<T>> {
+    static auto make()
+    {
+        const math::dynvector<T> result(generator<math::vector<T, 256>>::make());
+        return result;
+    }
+};
+
+template<typename V>
+static void vector_add(benchmark::State& state)
+{
+    bench::run<V, V>(state, [](const V& a, const V& b) { return a + b; });
+}
+
+template<typename V>
+static void vector_mul_scalar(benchmark::State& state)
+{
+    using T = std::remove_cvref_t<decltype(V{}[0])>;
+    bench::run<V, T>(state, [](const V& a, const T& s) { return a * s; });
+}
+
+template<typename V>
+static void vector_dot(benchmark::State& state)
+{
+    bench::run<V, V>(state, [](const V& a, const V& b) { return math::dot(a, b); });
+}
+
+template<typename V>
+static void vector_cross(benchmark::State& state)
+{
+    bench::run<V, V>(state, [](const V& a, const V& b) { return math::cross(a, b); });
+}
+
+template<typename V>
+static void vector_length(benchmark::State& state)
+{
+    bench::run<V>(state, [](const V& a) { return math::length(a); });
+}
+
+template<typename V>
+static void vector_normalize(benchmark::State& state)
+{
+    bench::run<V>(state, [](const V& a) { return math::normalize(a); });
+}
+
+// a * s + b - c on feature sized vectors, eager makes a temporary per
+// operator and the lazy expression evaluates once into the result
+template<typename V>
+static void vector_fused(benchmark::State& state)
+{
+    using T = std::remove_cvref_t<decltype(V{}[0])>;
+    bench::run<V, T, V, V>(state, [](const V& a, const T& s, const V& b, const V& c) { return a * s + b - c; });
+}
+
+template<typename V>
+static void vector_fused_lazy(benchmark::State& state)
+{
+    using T = std::remove_cvref_t<decltype(V{}[0])>;
+    bench::run<V, T, V, V>(state, [](const V& a, const T& s, const V& b, const V& c) {
+        const V result = math::lazy(a) * s + b - c;
+        return result;
+    });
+}
+
+template<typename V>
+static void vector_distance(benchmark::State& state)
+{
+    bench::run<V, V>(state, [](const V& a, const V& b) { return math::distance(a, b); });
+}
+
+// a chain of operators on small vectors, the scalar variant writes the same
+// chain out per component. Under LUCMATH_SIMD the four component chain
+// keeps its temporaries in registers, three component vectors take the
+// scalar path in either build. With avx-512 the compiler vectorizes the
+// scalar batch across elements and wins there, the horizontal dot is not
+template<typename V>
+static void vector_chain(benchmark::State& state)
+{
+    bench::run<V, V, V>(state, [](const V& a, const V& b, const V& c) {
+        if constexpr (sizeof(V) / sizeof(a[0]) == 3)
+            return a + b * c - math::cross(a, b) * math::dot(b, c);
+        else
+            return a + b * c - a * math::dot(b, c);
+    });
+}
+
+template<typename V>
+static void vector_chain_scalar(benchmark::State& state)
+{
+    bench::run<V, V, V>(state, [](const V& a, const V& b, const V& c) {
+        if constexpr (sizeof(V) / sizeof(a[0]) == 3) {
+            const auto d = b.x * c.x + b.y * c.y + b.z * c.z;
+            const V result(a.x + b.x * c.x - (a.y * b.z - a.z * b.y) * d,
+                           a.y + b.y * c.y - (a.z * b.x - a.x * b.z) * d,
+                           a.z + b.z * c.z - (a.x * b.y - a.y * b.x) * d);
+            return result;
+        }
+        else {
+            const auto d = b.x * c.x + b.y * c.y + b.z * c.z + b.w * c.w;
+            const V result(a.x + b.x * c.x - a.x * d,
+                           a.y + b.y * c.y - a.y * d,
+                           a.z + b.z * c.z - a.z * d,
+                           a.w + b.w * c.w - a.w * d);
+            return result;
+        }
+    });
+}
+
+LUCMATH_BENCH(vector_add, math::float3);
+LUCMATH_BENCH(vector_add, math::float4);
+LUCMATH_BENCH(vector_add, math::double3);
+LUCMATH_BENCH(vector_add, math::double4);
+LUCMATH_BENCH(vector_mul_scalar, math::float3);
+LUCMATH_BENCH(vector_mul_scalar, math::float4);
+LUCMATH_BENCH(vector_mul_scalar, math::double3);
+LUCMATH_BENCH(vector_mul_scalar, math::double4);
+LUCMATH_BENCH(vector_dot, math::float3);
+LUCMATH_BENCH(vector_dot, math::float4);
+LUCMATH_BENCH(vector_dot, math::double3);
+LUCMATH_BENCH(vector_dot, math::double4);
+LUCMATH_BENCH(vector_cross, math::float3);
+LUCMATH_BENCH(vector_cross, math::double3);
+LUCMATH_BENCH(vector_length, math::float3);
+LUCMATH_BENCH(vector_length, math::double3);
+LUCMATH_BENCH(vector_normalize, math::float3);
+LUCMATH_BENCH(vector_normalize, math::float4);
+LUCMATH_BENCH(vector_normalize, math::double3);
+LUCMATH_BENCH(vector_normalize, math::double4);
+LUCMATH_BENCH(vector_fused, math::vector<float, 16>);
+LUCMATH_BENCH(vector_fused, math::vector<float, 64>);
+LUCMATH_BENCH(vector_fused_lazy, math::vector<float, 16>);
+LUCMATH_BENCH(vector_fused_lazy, math::vector<float, 64>);
+LUCMATH_BENCH(vector_dot, math::vector<float, 256>);
+LUCMATH_BENCH(vector_dot, math::dynvector<float>);
+LUCMATH_BENCH(vector_distance, math::vector<float, 256>);
+LUCMATH_BENCH(vector_distance, math::dynvector<float>);
+LUCMATH_BENCH(vector_normalize, math::vector<float, 256>);
+LUCMATH_BENCH(vector_normalize, math::dynvector<float>);
+LUCMATH_BENCH(vector_chain, math::float3);
+LUCMATH_BENCH(vector_chain, math::float4);
+LUCMATH_BENCH(vector_chain, math::double4);
+LUCMATH_BENCH(vector_chain_scalar, math::float3);
+LUCMATH_BENCH(vector_chain_scalar, math::float4);
+LUCMATH_BENCH(vector_chain_scalar, math::double4);
@@ -0,0 +1,81 @@
+# compile time of each lucmath_bench translation unit, once parsing the
+# headers from source and once with math.hpp precompiled and force included,
+# the way LUCMATH_PCH builds it. run through the bench_compile_time target,
+# which writes the compiler, flags and sources of lucmath_bench to ARGS.
+# REPEAT sets how many compiles the fastest time is taken from
+cmake_minimum_required(VERSION 3.23)
+
+include(${ARGS})
+if(NOT DEFINED REPEAT)
+    set(REPEAT 3)
+endif()
+
+separate_arguments(FLAGS UNIX_COMMAND "${FLAGS}")
+list(REMOVE_DUPLICATES INCLUDES)
+list(REMOVE_ITEM INCLUDES ${IMPLICIT_INCLUDES})
+list(TRANSFORM DEFINITIONS PREPEND -D)
+list(TRANSFORM INCLUDES PREPEND -I)
+set(flags ${FLAGS} ${OPTIONS} ${DEFINITIONS} ${INCLUDES})
+
+set(pch_dir ${BINARY_DIR}/compile_time)
+file(MAKE_DIRECTORY ${pch_dir})
+if(COMPILER_ID STREQUAL "GNU")
+    set(pch_file ${pch_dir}/math.hpp.gch)
+    set(pch_use -include ${pch_dir}/math.hpp)
+elseif(COMPILER_ID MATCHES "Clang")
+    set(pch_file ${pch_dir}/math.hpp.pch)
+    set(pch_use -include-pch ${pch_file})
+else()
+    message(FATAL_ERROR "compile_time.cmake: precompiled headers are only timed for GCC and Clang")
+endif()
+
+# fastest of REPEAT compiles in milliseconds
+function(compile_ms out)
+    set(best -1)
+    foreach(i RANGE 1 ${REPEAT})
+        string(TIMESTAMP start "%s%f")
+        execute_process(COMMAND ${CXX} ${flags} ${ARGN}
+            RESULT_VARIABLE status ERROR_VARIABLE error OUTPUT_QUIET)
+        string(TIMESTAMP stop "%s%f")
+        if(NOT status EQUAL 0)
+            message(FATAL_ERROR "${error}")
+        endif()
+        math(EXPR ms "(${stop} - ${start}) / 1000")
+        if(best LESS 0 OR ms LESS best)
+            set(best ${ms})
+        endif()
+    endforeach()
+    set(${out} ${best} PARENT_SCOPE)
+endfunction()
+
+# one line of the table, the name left aligned and the times right aligned
+function(print_row name before after)
+    string(LENGTH "${name}" length)
+    while(length LESS 24)
+        string(APPEND name " ")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    foreach(column before after)
+        string(LENGTH "${${column}}" length)
+        while(length LESS 11)
+            string(PREPEND ${column} " ")
+            math(EXPR length "${length} + 1")
+        endwhile()
+    endforeach()
+    message("${name}${before}${after}")
+endfunction()
+
+compile_ms(pch_ms -x c++-header ${HEADER} -o ${pch_file})
+message("math.hpp precompiled once in ${pch_ms} ms\n")
+print_row("translation unit" "source ms" "pch ms")
+
+set(source_total 0)
+set(pch_total 0)
+foreach(source IN LISTS SOURCES)
+    compile_ms(before -c ${SOURCE_DIR}/${source} -o ${pch_dir}/source.o)
+    compile_ms(after ${pch_use} -c ${SOURCE_DIR}/${source} -o ${pch_dir}/pch.o)
+    math(EXPR source_total "${source_total} + ${before}")
+    math(EXPR pch_total "${pch_total} + ${after}")
+    print_row(${source} ${before} ${after})
+endforeach()
+print_row(total ${source_total} ${pch_total})
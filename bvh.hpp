@@ -0,0 +1,467 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BVH_MATH_H
+#define BVH_MATH_H
+
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "triangle.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <utility>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace math {
+
+// interior nodes keep their left child directly after them and the right
+// child at offset, leaves address count entries of bvh::indices at offset
+template<typename T>
+struct alignas(32) bvh_node {
+    vector<T, 3> min;
+    uint32_t offset;
+    vector<T, 3> max;
+    uint32_t count;
+
+    auto leaf() const
+    {
+        return count != 0;
+    }
+};
+
+static_assert(sizeof(bvh_node<float>) == 32);
+
+template<typename T>
+struct bvh_hit {
+    uint32_t index;
+    T t;
+};
+
+template<typename T>
+auto half_area(const bounds<T, 3>& b)
+{
+    const auto e = b.max - b.min;
+    const auto result = e.x * e.y + e.y * e.z + e.z * e.x;
+    return result;
+}
+
+// binned surface area heuristic build, nodes are flattened depth-first
+template<typename T>
+struct bvh {
+    using node = bvh_node<T>;
+
+    static constexpr size_t bins = 16;
+    static constexpr size_t max_leaf_size = 8;
+    static constexpr T traversal_cost = T(1);
+    // builds above this many primitives fork subtrees onto other cores
+    static constexpr size_t parallel_threshold = size_t(1) << 20;
+    static constexpr size_t task_threshold = size_t(1) << 14;
+    static constexpr uint32_t miss_index = ~uint32_t(0);
+
+    bvh() = default;
+
+    explicit bvh(std::span<const bounds<T, 3>> primitives)
+    {
+        std::vector<reference> refs(primitives.size());
+        for (size_t i = 0; i < primitives.size(); i++)
+            refs[i] = reference{ primitives[i], primitives[i].center(), uint32_t(i) };
+        build(refs);
+    }
+
+    explicit bvh(std::span<const triangle<T>> triangles)
+    {
+        std::vector<reference> refs(triangles.size());
+        for (size_t i = 0; i < triangles.size(); i++) {
+            const auto& [a, b, c] = triangles[i];
+            refs[i] = reference{ bounds<T, 3>(a, b, c), triangle_center(a, b, c), uint32_t(i) };
+        }
+        build(refs);
+    }
+
+    // intersect(index, t) tests primitive index against the ray and, on a
+    // hit closer than t, shrinks t and returns true
+    template<typename F>
+    std::optional<bvh_hit<T>> closest_hit(const ray<T, 3>& r, T tmin, T tmax, F&& intersect) const
+    {
+        std::optional<bvh_hit<T>> result;
+        if (nodes.empty())
+            return result;
+        const auto inv = T(1) / r.d;
+        std::array<uint32_t, stack_size> stack;
+        size_t top = 0;
+        uint32_t current = 0;
+        if (enter(nodes[0], r.p, inv, tmin, tmax) == miss)
+            return result;
+        for (;;) {
+            const auto& n = nodes[current];
+            if (n.leaf()) {
+                for (uint32_t i = n.offset; i < n.offset + n.count; i++)
+                    if (intersect(indices[i], tmax))
+                        result = bvh_hit<T>{ indices[i], tmax };
+            }
+            else {
+                auto near = current + 1;
+                auto far = n.offset;
+                auto t_near = enter(nodes[near], r.p, inv, tmin, tmax);
+                auto t_far = enter(nodes[far], r.p, inv, tmin, tmax);
+                if (t_far < t_near) {
+                    std::swap(near, far);
+                    std::swap(t_near, t_far);
+                }
+                if (t_near != miss) {
+                    if (t_far != miss)
+                        stack[top++] = far;
+                    current = near;
+                    continue;
+                }
+            }
+            // entries pushed before tmax shrank may no longer be reachable
+            do {
+                if (top == 0)
+                    return result;
+                current = stack[--top];
+            } while (enter(nodes[current], r.p, inv, tmin, tmax) == miss);
+        }
+    }
+
+    // stops at the first primitive intersect reports, in no particular order
+    template<typename F>
+    auto any_hit(const ray<T, 3>& r, T tmin, T tmax, F&& intersect) const
+    {
+        if (nodes.empty())
+            return false;
+        const auto inv = T(1) / r.d;
+        std::array<uint32_t, stack_size> stack;
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top) {
+            const auto current = stack[--top];
+            const auto& n = nodes[current];
+            if (enter(n, r.p, inv, tmin, tmax) == miss)
+                continue;
+            if (n.leaf()) {
+                for (uint32_t i = n.offset; i < n.offset + n.count; i++) {
+                    auto t = tmax;
+                    if (intersect(indices[i], t))
+                        return true;
+                }
+            }
+            else {
+                stack[top++] = n.offset;
+                stack[top++] = current + 1;
+            }
+        }
+        return false;
+    }
+
+    // coherent traversal, a node is entered while any active ray reaches it.
+    // intersect(index, rays) returns the hit distance per ray, infinity on a
+    // miss. rays.tmax shrinks to the closest hits, whose indices are returned
+    template<size_t W, typename F>
+    auto closest_hit(ray_packet<T, W>& rays, F&& intersect) const
+    {
+        std::array<uint32_t, W> result;
+        result.fill(miss_index);
+        if (nodes.empty() || simd::none(math::intersect(rays, box(nodes[0])) < simd::pack<T, W>(miss)))
+            return result;
+        std::array<uint32_t, stack_size> stack;
+        size_t top = 0;
+        uint32_t current = 0;
+        for (;;) {
+            const auto& n = nodes[current];
+            if (n.leaf()) {
+                for (uint32_t i = n.offset; i < n.offset + n.count; i++) {
+                    const auto t = intersect(indices[i], std::as_const(rays));
+                    const auto closer = t < rays.tmax;
+                    auto bits = simd::bitmask(closer);
+                    if (bits == 0)
+                        continue;
+                    rays.tmax = simd::select(closer, t, rays.tmax);
+                    for (; bits; bits &= bits - 1)
+                        result[size_t(std::countr_zero(bits))] = indices[i];
+                }
+            }
+            else {
+                auto near = current + 1;
+                auto far = n.offset;
+                const auto t_left = math::intersect(rays, box(nodes[near]));
+                const auto t_right = math::intersect(rays, box(nodes[far]));
+                auto t_near = simd::reduce_min(t_left);
+                auto t_far = simd::reduce_min(t_right);
+                if (t_far < t_near) {
+                    std::swap(near, far);
+                    std::swap(t_near, t_far);
+                }
+                if (t_near != miss) {
+                    if (t_far != miss)
+                        stack[top++] = far;
+                    current = near;
+                    continue;
+                }
+            }
+            do {
+                if (top == 0)
+                    return result;
+                current = stack[--top];
+            } while (simd::none(math::intersect(rays, box(nodes[current])) < simd::pack<T, W>(miss)));
+        }
+    }
+
+    std::vector<node> nodes;
+    std::vector<uint32_t> indices;
+
+  private:
+    // traversal keeps one stack entry per level and any_hit one more. Below
+    // sah_depth nodes are halved by count, which adds at most 32 levels for
+    // uint32_t indices, so nested or otherwise degenerate input cannot
+    // outgrow the stack
+    static constexpr size_t stack_size = 96;
+    static constexpr size_t sah_depth = stack_size - 33;
+    static constexpr T miss = std::numeric_limits<T>::infinity();
+
+    // primitives are partitioned by value so every pass streams memory
+    struct reference {
+        bounds<T, 3> box;
+        vector<T, 3> centroid;
+        uint32_t index;
+    };
+
+    // box bounds the primitives, centers their centroids
+    struct bin {
+        bounds<T, 3> box;
+        bounds<T, 3> centers;
+        uint32_t count = 0;
+
+        // an empty bounds would extend by its inverted min and max
+        auto& extend(const bin& b)
+        {
+            if (b.count == 0)
+                return *this;
+            box.extend(b.box);
+            centers.extend(b.centers);
+            count += b.count;
+            return *this;
+        }
+    };
+
+    struct split {
+        size_t axis;
+        size_t bin;
+        T scale;
+        T cost;
+        std::array<bounds<T, 3>, 2> box;
+        std::array<bounds<T, 3>, 2> centers;
+    };
+
+    static auto box(const node& n)
+    {
+        bounds<T, 3> result;
+        result.min = n.min;
+        result.max = n.max;
+        return result;
+    }
+
+    // entry distance of the slab test, miss when the ray passes the box
+    static auto enter(const node& n, const vector<T, 3>& origin, const vector<T, 3>& inv, T tmin, T tmax)
+    {
+        for (size_t a = 0; a < 3; a++) {
+            const auto t0 = (n.min[a] - origin[a]) * inv[a];
+            const auto t1 = (n.max[a] - origin[a]) * inv[a];
+            tmin = std::max(tmin, std::min(t0, t1));
+            tmax = std::min(tmax, std::max(t0, t1));
+        }
+        const auto result = tmin <= tmax ? tmin : miss;
+        return result;
+    }
+
+    static auto bin_of(T c, T lo, T scale, size_t used)
+    {
+        const auto result = std::min(used - 1, size_t((c - lo) * scale));
+        return result;
+    }
+
+    void build(std::span<reference> refs)
+    {
+        nodes.clear();
+        indices.resize(refs.size());
+        if (refs.empty())
+            return;
+        nodes.reserve(2 * refs.size());
+        const auto forks = refs.size() > parallel_threshold ? std::bit_width(std::thread::hardware_concurrency()) + 1 : 0;
+        const auto root = measure(refs);
+        build_node(refs, root.box, root.centers, 0, 0, nodes, size_t(forks));
+        for (size_t i = 0; i < refs.size(); i++)
+            indices[i] = refs[i].index;
+    }
+
+    static std::optional<split> find_split(std::span<const reference> items, const bounds<T, 3>& centers)
+    {
+        // small nodes get fewer bins, there is nothing to gain from empty ones
+        const auto used = std::min(bins, items.size());
+        vector<T, 3> scale;
+        for (size_t axis = 0; axis < 3; axis++) {
+            const auto extent = centers.max[axis] - centers.min[axis];
+            scale[axis] = extent > T(0) ? T(used) / extent : T(0);
+        }
+        std::array<std::array<bin, bins>, 3> binned;
+        for (const auto& r : items) {
+            for (size_t axis = 0; axis < 3; axis++) {
+                auto& b = binned[axis][bin_of(r.centroid[axis], centers.min[axis], scale[axis], used)];
+                b.box.extend(r.box);
+                b.centers.extend(r.centroid);
+                b.count++;
+            }
+        }
+
+        std::optional<split> result;
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (scale[axis] == T(0))
+                continue;
+            // right_cost[k] is the area weighted count of bins above k
+            std::array<T, bins> right_cost;
+            bin right;
+            for (size_t k = used - 1; k > 0; k--) {
+                right.extend(binned[axis][k]);
+                right_cost[k - 1] = right.count ? half_area(right.box) * T(right.count) : T(0);
+            }
+            bin left;
+            for (size_t k = 0; k + 1 < used; k++) {
+                left.extend(binned[axis][k]);
+                if (left.count == 0 || left.count == items.size())
+                    continue;
+                const auto cost = half_area(left.box) * T(left.count) + right_cost[k];
+                if (!result || cost < result->cost)
+                    result = split{ axis, k + 1, scale[axis], cost, {}, {} };
+            }
+        }
+        // children inherit their bounds from the bins so they skip a pass
+        if (result) {
+            std::array<bin, 2> sides{};
+            for (size_t k = 0; k < used; k++)
+                sides[k < result->bin ? 0 : 1].extend(binned[result->axis][k]);
+            for (size_t side = 0; side < 2; side++) {
+                result->box[side] = sides[side].box;
+                result->centers[side] = sides[side].centers;
+            }
+        }
+        return result;
+    }
+
+    static auto measure(std::span<const reference> items)
+    {
+        bin result;
+        for (const auto& r : items) {
+            result.box.extend(r.box);
+            result.centers.extend(r.centroid);
+        }
+        result.count = uint32_t(items.size());
+        return result;
+    }
+
+    static void build_node(std::span<reference> items, const bounds<T, 3>& box, const bounds<T, 3>& centers,
+                           uint32_t first, size_t depth, std::vector<node>& out, size_t forks)
+    {
+        const auto at = out.size();
+        out.push_back(node{ box.min, first, box.max, uint32_t(items.size()) });
+        if (items.size() == 1)
+            return;
+
+        size_t count = items.size() / 2;
+        std::array<bounds<T, 3>, 2> child_box, child_centers;
+        const auto best = depth < sah_depth ? find_split(items, centers) : std::nullopt;
+        if (best) {
+            const auto area = half_area(box);
+            const auto leaf_cost = area * T(items.size());
+            if (items.size() <= max_leaf_size && best->cost + traversal_cost * area >= leaf_cost)
+                return;
+            const auto axis = best->axis;
+            const auto lo = centers.min[axis];
+            const auto used = std::min(bins, items.size());
+            const auto mid = std::partition(items.begin(), items.end(), [&](const reference& r) {
+                return bin_of(r.centroid[axis], lo, best->scale, used) < best->bin;
+            });
+            count = size_t(mid - items.begin());
+            child_box = best->box;
+            child_centers = best->centers;
+        }
+        else if (items.size() <= max_leaf_size) {
+            return;
+        }
+        else if (depth >= sah_depth) {
+            const auto e = centers.max - centers.min;
+            const auto axis = e.x > e.y ? (e.x > e.z ? 0 : 2) : (e.y > e.z ? 1 : 2);
+            std::nth_element(items.begin(), items.begin() + count, items.end(), [&](const reference& a, const reference& b) {
+                return a.centroid[axis] < b.centroid[axis];
+            });
+        }
+
+        // coincident centroids leave nothing to bin, those and nodes below
+        // sah_depth are halved by count
+        const auto left = items.first(count);
+        const auto right = items.subspan(count);
+        if (!best) {
+            const std::array<bin, 2> sides{ measure(left), measure(right) };
+            for (size_t side = 0; side < 2; side++) {
+                child_box[side] = sides[side].box;
+                child_centers[side] = sides[side].centers;
+            }
+        }
+        const auto right_first = first + uint32_t(count);
+        out[at].count = 0;
+        if (forks && items.size() >= task_threshold) {
+            auto task = std::async(std::launch::async, [&] {
+                std::vector<node> sub;
+                build_node(right, child_box[1], child_centers[1], right_first, depth + 1, sub, forks - 1);
+                return sub;
+            });
+            build_node(left, child_box[0], child_centers[0], first, depth + 1, out, forks - 1);
+            auto sub = task.get();
+            const auto base = uint32_t(out.size());
+            for (auto& n : sub)
+                if (!n.leaf())
+                    n.offset += base;
+            out[at].offset = base;
+            out.insert(out.end(), sub.begin(), sub.end());
+        }
+        else {
+            build_node(left, child_box[0], child_centers[0], first, depth + 1, out, forks);
+            out[at].offset = uint32_t(out.size());
+            build_node(right, child_box[1], child_centers[1], right_first, depth + 1, out, forks);
+        }
+    }
+};
+
+using bvhf = bvh<float>;
+using bvhd = bvh<double>;
+
+} // namespace math
+
+#endif /* BVH_MATH_H */
@@ -24,7 +24,9 @@
 #define DEKKER_MATH_H
 
 #include "vector.hpp"
+#include "simd.hpp"
 #include <cmath>
+#include <type_traits>
 
 namespace math {
 
@@ -64,7 +66,7 @@ constexpr dekker dekker_addition(const dekker& a, const dekker& b)
 
 constexpr dekker dekker_subtraction(const dekker& a, const dekker& b)
 {
-    const double T = a.h + b.h;
+    const double T = a.h - b.h;
     double t{};
     if (std::abs(a.h) > std::abs(b.h))
         t = a.h - T - b.h + a.l - b.l;
@@ -74,6 +76,14 @@ constexpr dekker dekker_subtraction(const dekker& a, const dekker& b)
     return { R, T - R + t };
 }
 
+// Knuth's two-sum, the exact sum whichever operand is larger
+constexpr dekker dekker_add12(const double& a, const double& b)
+{
+    const auto s = a + b;
+    const auto v = s - a;
+    return { s, (a - (s - v)) + (b - v) };
+}
+
 constexpr dekker dekker_split(const double& x)
 {
     constexpr double SCALE = 134217729;
@@ -82,14 +92,35 @@ constexpr dekker dekker_split(const double& x)
     return { R, x - R };
 }
 
-constexpr dekker dekker_mul12(const double& a, const double& b)
+// the exact product through Veltkamp halves, needs no fma but is only
+// exact when the compiler does not contract it into one. The parts sum to
+// a * b, the high part can be an ulp off a * b rounded
+constexpr dekker dekker_mul12_split(const double& a, const double& b)
 {
     const auto A = dekker_split(a);
     const auto B = dekker_split(b);
     const auto p = A.h * B.h;
     const auto q = A.h * B.l + A.l * B.h;
     const auto R = p + q;
-    return { R, p - R + q + A.l * b };
+    return { R, p - R + q + A.l * B.l };
+}
+
+// the rounding error of a product is a double, one fma recovers it
+inline dekker dekker_mul12_fma(const double& a, const double& b)
+{
+    const auto p = a * b;
+    return { p, std::fma(a, b, -p) };
+}
+
+// fma where the hardware has it, std::fma is not constexpr so constant
+// evaluation keeps the split
+constexpr dekker dekker_mul12(const double& a, const double& b)
+{
+#if defined(FP_FAST_FMA)
+    if (!std::is_constant_evaluated())
+        return dekker_mul12_fma(a, b);
+#endif
+    return dekker_mul12_split(a, b);
 }
 
 constexpr dekker dekker_multiplication(const dekker& a, const dekker& b)
@@ -188,6 +219,139 @@ constexpr auto length(const vector<dekker, N>& a)
     return result;
 }
 
+// W double-doubles, high and low parts one register each
+template<size_t W>
+struct dekker_soa {
+    using lane = simd::pack<double, W>;
+
+    dekker_soa() = default;
+
+    dekker_soa(const lane& h, const lane& l) :
+      h(h), l(l) {}
+
+    dekker_soa(const dekker& d) :
+      h(d.h), l(d.l) {}
+
+    // a single lane reads the members, which leaves the loop around it to
+    // the auto-vectorizer
+    static auto load(const dekker* p)
+    {
+        if constexpr (W == 1)
+            return dekker_soa(lane(p->h), lane(p->l));
+        else {
+            const auto parts = simd::load_interleaved<2, W>(reinterpret_cast<const double*>(p));
+            return dekker_soa(parts[0], parts[1]);
+        }
+    }
+
+    auto store(dekker* p) const
+    {
+        if constexpr (W == 1)
+            *p = dekker(h[0], l[0]);
+        else
+            simd::store_interleaved<2, W>(std::array<lane, 2>{ h, l }, reinterpret_cast<double*>(p));
+    }
+
+    lane h, l;
+};
+
+// the scalar functions above stay the reference, the lane versions give the
+// same results without the magnitude branch. Knuth's two-sum recovers the
+// rounding error whichever operand is larger. The steps are written out,
+// gcc keeps pair returning helpers on the stack
+
+// the exact product, a fused multiply-add gives its error directly, without
+// one Veltkamp splits both factors in halves whose products are exact
+template<size_t W>
+constexpr auto dekker_mul12(const simd::pack<double, W>& a, const simd::pack<double, W>& b)
+{
+    const auto p = a * b;
+#if defined(FP_FAST_FMA)
+    const auto e = simd::fmadd(a, b, -p);
+#else
+    const simd::pack<double, W> scale(134217729.0);
+    const auto sa = a * scale;
+    const auto ah = sa - (sa - a);
+    const auto al = a - ah;
+    const auto sb = b * scale;
+    const auto bh = sb - (sb - b);
+    const auto bl = b - bh;
+    const auto e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+#endif
+    return dekker_soa<W>(p, e);
+}
+
+template<size_t W>
+constexpr auto dekker_add12(const simd::pack<double, W>& a, const simd::pack<double, W>& b)
+{
+    const auto s = a + b;
+    const auto v = s - a;
+    return dekker_soa<W>(s, (a - (s - v)) + (b - v));
+}
+
+template<size_t W>
+constexpr auto dekker_addition(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    const auto T = a.h + b.h;
+    const auto v = T - a.h;
+    const auto t = (a.h - (T - v)) + (b.h - v) + a.l + b.l;
+    const auto R = T + t;
+    return dekker_soa<W>(R, t - (R - T));
+}
+
+template<size_t W>
+constexpr auto dekker_subtraction(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    const auto T = a.h - b.h;
+    const auto v = T - a.h;
+    const auto t = (a.h - (T - v)) - (b.h + v) + a.l - b.l;
+    const auto R = T + t;
+    return dekker_soa<W>(R, t - (R - T));
+}
+
+template<size_t W>
+constexpr auto dekker_multiplication(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    const auto T = dekker_mul12(a.h, b.h);
+    const auto C = a.h * b.l + a.l * b.h + T.l;
+    const auto R = T.h + C;
+    return dekker_soa<W>(R, C - (R - T.h));
+}
+
+template<size_t W>
+constexpr auto dekker_division(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    const auto U = a.h / b.h;
+    const auto T = dekker_mul12(U, b.h);
+    const auto L = (a.h - T.h - T.l + a.l - U * b.l) / b.h;
+    const auto R = U + L;
+    return dekker_soa<W>(R, L - (R - U));
+}
+
+template<size_t W>
+constexpr auto operator+(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    return dekker_addition(a, b);
+}
+
+template<size_t W>
+constexpr auto operator-(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    return dekker_subtraction(a, b);
+}
+
+template<size_t W>
+constexpr auto operator*(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    return dekker_multiplication(a, b);
+}
+
+template<size_t W>
+constexpr auto operator/(const dekker_soa<W>& a, const dekker_soa<W>& b)
+{
+    return dekker_division(a, b);
+}
+
 using dekker2 = vector<dekker, 2>;
 using dekker3 = vector<dekker, 3>;
 using dekker4 = vector<dekker, 4>;
@@ -0,0 +1,239 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef DUAL_QUATERNION_MATH_H
+#define DUAL_QUATERNION_MATH_H
+
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "affine.hpp"
+#include "simd.hpp"
+#include "vector_soa.hpp"
+#include "transform.hpp"
+#include "thread_pool.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace math {
+
+// a rigid transform as real + e dual, real is the rotation and dual half
+// the translation times it. Composition and blending stay quaternion
+// arithmetic and a blend of rotations does not collapse like a blend of
+// matrices does
+template<typename T>
+struct dual_quaternion {
+    quaternion<T> real;
+    quaternion<T> dual;
+
+    constexpr dual_quaternion() :
+      real(), dual(T(0)) {}
+
+    constexpr dual_quaternion(const quaternion<T>& r, const quaternion<T>& d) :
+      real(r), dual(d) {}
+
+    // rotates first, then translates
+    constexpr dual_quaternion(const quaternion<T>& rot, const vector<T, 3>& pos) :
+      real(rot), dual(quaternion<T>(pos, T(0)) * rot * T(.5)) {}
+
+    // scale and shear are dropped, the orientation is orthonormalized before
+    // the rotation is read from it
+    explicit dual_quaternion(const affine<T>& a) :
+      dual_quaternion(normalize(from_rotation(orthonormalize(a.orientation))), a.position) {}
+
+    explicit dual_quaternion(const matrix<T, 4, 4>& m) :
+      dual_quaternion(affine<T>(m)) {}
+};
+
+static_assert(sizeof(dual_quaternion<float>) == 8 * sizeof(float));
+
+template<typename T>
+constexpr auto operator+(const dual_quaternion<T>& lhs, const dual_quaternion<T>& rhs)
+{
+    const dual_quaternion<T> result(lhs.real + rhs.real, lhs.dual + rhs.dual);
+    return result;
+}
+
+template<typename T>
+constexpr auto operator*(const dual_quaternion<T>& lhs, const T& rhs)
+{
+    const dual_quaternion<T> result(lhs.real * rhs, lhs.dual * rhs);
+    return result;
+}
+
+template<typename T>
+constexpr auto operator*(const T& lhs, const dual_quaternion<T>& rhs)
+{
+    const dual_quaternion<T> result(lhs * rhs.real, lhs * rhs.dual);
+    return result;
+}
+
+// rhs applied first, then lhs
+template<typename T>
+constexpr auto operator*(const dual_quaternion<T>& lhs, const dual_quaternion<T>& rhs)
+{
+    const dual_quaternion<T> result(lhs.real * rhs.real, lhs.real * rhs.dual + lhs.dual * rhs.real);
+    return result;
+}
+
+// a blend of unit dual quaternions divided by the length of its real part
+template<typename T>
+constexpr auto normalize(const dual_quaternion<T>& q)
+{
+    const auto len = length(q.real);
+    const auto il = T(1) / (len == T(0) ? T(1) : len);
+    const auto result = q * il;
+    return result;
+}
+
+// the inverse of a unit dual quaternion
+template<typename T>
+constexpr auto inverse(const dual_quaternion<T>& q)
+{
+    const dual_quaternion<T> result(conjugate(q.real), conjugate(q.dual));
+    return result;
+}
+
+template<typename T>
+constexpr auto translation(const dual_quaternion<T>& q)
+{
+    const auto& r = q.real;
+    const auto& d = q.dual;
+    const auto result = (d.ijk * r.w - r.ijk * d.w + cross(r.ijk, d.ijk)) * T(2);
+    return result;
+}
+
+// v + 2 u x (u x v + w v) for the unit real part (u, w)
+template<typename T>
+constexpr auto transform_vector(const dual_quaternion<T>& q, const vector<T, 3>& v)
+{
+    const auto& u = q.real.ijk;
+    const auto result = v + cross(u, cross(u, v) + v * q.real.w) * T(2);
+    return result;
+}
+
+template<typename T>
+constexpr auto transform_point(const dual_quaternion<T>& q, const vector<T, 3>& p)
+{
+    const auto result = transform_vector(q, p) + translation(q);
+    return result;
+}
+
+template<typename T>
+constexpr auto to_affine(const dual_quaternion<T>& q)
+{
+    const affine<T> result(rotation3(q.real), translation(q));
+    return result;
+}
+
+template<typename T>
+constexpr auto to_matrix(const dual_quaternion<T>& q)
+{
+    const auto result = to_matrix(to_affine(q));
+    return result;
+}
+
+// meshes with more vertices than this are skinned on the thread pool
+inline constexpr size_t skin_parallel_threshold = size_t(1) << 14;
+
+// dual quaternion linear blending of the vertices in [first, last). The
+// bones of a vertex are gathered and blended as eight lane rows into a
+// chunk, bones on the other hemisphere of the first one take the negated
+// weight so the shortest arc is blended. The chunk is then read back as
+// packets of batch_width lanes, long after the row stores have retired
+inline constexpr size_t skin_chunk = 64;
+static_assert(skin_parallel_threshold % skin_chunk == 0);
+
+template<typename T, size_t K, typename I>
+auto skin(std::span<const dual_quaternion<T>> bones, std::span<const vector<T, 3>> positions, std::span<const std::array<I, K>> indices, std::span<const vector<T, K>> weights, std::span<vector<T, 3>> out, size_t first, size_t last)
+{
+    constexpr auto W = batch_width<T>;
+    static_assert(skin_chunk % W == 0);
+    using lane = simd::pack<T, W>;
+    const auto two = lane(T(2));
+    std::array<std::array<T, 8>, skin_chunk> blend{};
+    for (size_t chunk = first; chunk < last; chunk += skin_chunk) {
+        const auto m = std::min(skin_chunk, last - chunk);
+        for (size_t l = 0; l < m; l++) {
+            const auto& index = indices[chunk + l];
+            const auto& weight = weights[chunk + l];
+            const auto& pivot = bones[index[0]];
+            auto b = simd::pack<T, 8>::load(reinterpret_cast<const T*>(&pivot)) * simd::pack<T, 8>(weight[0]);
+            for (size_t k = 1; k < K; k++) {
+                const auto& bone = bones[index[k]];
+                const auto& r = bone.real;
+                const auto d = (r.x * pivot.real.x + r.y * pivot.real.y) + (r.z * pivot.real.z + r.w * pivot.real.w);
+                const auto w = std::copysign(weight[k], d);
+                b = simd::fmadd(simd::pack<T, 8>::load(reinterpret_cast<const T*>(&bone)), simd::pack<T, 8>(w), b);
+            }
+            b.store(blend[l].data());
+        }
+        for (size_t l = 0; l < m; l += W) {
+            const auto i = chunk + l;
+            const auto n = std::min(W, m - l);
+            const auto q = simd::load_interleaved<8, W>(blend[l].data());
+            // the transform is quadratic in the blend, the rotation and
+            // translation terms are scaled by one over the squared length
+            // instead of normalizing both parts with a square root
+            const auto ls = simd::fmadd(q[3], q[3], simd::fmadd(q[2], q[2], simd::fmadd(q[1], q[1], q[0] * q[0])));
+            const auto il = two / simd::select(ls == lane(T(0)), lane(T(1)), ls);
+            // translation (w d - dw u + u x d) and rotation u x (u x v + w v)
+            const auto tx = simd::fmadd(q[3], q[4], simd::fmadd(q[1], q[6], -simd::fmadd(q[7], q[0], q[2] * q[5])));
+            const auto ty = simd::fmadd(q[3], q[5], simd::fmadd(q[2], q[4], -simd::fmadd(q[7], q[1], q[0] * q[6])));
+            const auto tz = simd::fmadd(q[3], q[6], simd::fmadd(q[0], q[5], -simd::fmadd(q[7], q[2], q[1] * q[4])));
+            const auto v = vector_soa<T, 3, W>::load(positions.subspan(i, n));
+            const auto cx = simd::fmadd(q[1], v[2], simd::fmadd(q[3], v[0], -(q[2] * v[1])));
+            const auto cy = simd::fmadd(q[2], v[0], simd::fmadd(q[3], v[1], -(q[0] * v[2])));
+            const auto cz = simd::fmadd(q[0], v[1], simd::fmadd(q[3], v[2], -(q[1] * v[0])));
+            const auto x = simd::fmadd(q[1] * cz - q[2] * cy + tx, il, v[0]);
+            const auto y = simd::fmadd(q[2] * cx - q[0] * cz + ty, il, v[1]);
+            const auto z = simd::fmadd(q[0] * cy - q[1] * cx + tz, il, v[2]);
+            const vector_soa<T, 3, W> result({ x, y, z });
+            result.store(out.subspan(i, n));
+        }
+    }
+}
+
+// skinned positions of up to K bone influences per vertex, weights are
+// expected to be non-negative and to sum to one, indices to be in range of
+// bones. Replaces a palette of blended matrices with eight elements per
+// bone and keeps the volume where blended matrices collapse a twisted
+// joint. Large meshes are split into vertex ranges skinned on the thread
+// pool, skin_many<float>(bones, positions, indices, weights, out)
+template<typename T, size_t K = 4, typename I = uint16_t>
+auto skin_many(std::type_identity_t<std::span<const dual_quaternion<T>>> bones, span_in<T, 3> positions, std::type_identity_t<std::span<const std::array<I, K>>> indices, span_in<T, K> weights, span_out<T, 3> out)
+{
+    const auto count = std::min({ positions.size(), indices.size(), weights.size(), out.size() });
+    // ranges start on whole chunks, so every packet but the last is full
+    parallel_for(count, skin_parallel_threshold, [&](size_t first, size_t last) {
+        skin(bones, positions, indices, weights, out, first, last);
+    });
+}
+
+using dual_quaternionf = dual_quaternion<float>;
+using dual_quaterniond = dual_quaternion<double>;
+
+} // namespace math
+
+#endif /* DUAL_QUATERNION_MATH_H */
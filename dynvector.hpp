@@ -0,0 +1,248 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef DYNVECTOR_MATH_H
+#define DYNVECTOR_MATH_H
+
+#include "vector.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace math {
+
+// a vector sized at runtime for embeddings and feature rows, on the heap or
+// on an arena through the pmr alias. It shares the run kernels with the long
+// vector<T, N>, operations on two of them cover the shorter one and the
+// result takes the allocator of the left operand
+template<typename T, typename Allocator = std::allocator<T>>
+struct dynvector {
+    dynvector() = default;
+
+    explicit dynvector(const Allocator& allocator) :
+      values(allocator) {}
+
+    explicit dynvector(size_t n, const T& t = T(), const Allocator& allocator = Allocator()) :
+      values(n, t, allocator) {}
+
+    dynvector(std::initializer_list<T> t, const Allocator& allocator = Allocator()) :
+      values(t, allocator) {}
+
+    template<size_t N>
+    explicit dynvector(const vector<T, N>& v, const Allocator& allocator = Allocator()) :
+      values(&v[0], &v[0] + N, allocator) {}
+
+    T& operator[](std::size_t i)
+    {
+        return values[i];
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return values[i];
+    }
+
+    auto size() const
+    {
+        return values.size();
+    }
+
+    auto data()
+    {
+        return values.data();
+    }
+
+    auto data() const
+    {
+        return values.data();
+    }
+
+    auto as_span() const
+    {
+        return std::span<const T>(values);
+    }
+
+    std::vector<T, Allocator> values;
+};
+
+template<typename T>
+using pmr_dynvector = dynvector<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T, typename A, typename F>
+auto loop_op(size_t n, const A& allocator, F&& f)
+{
+    dynvector<T, A> result(n, T(), allocator);
+    simd::apply_n(result.data(), n, f);
+    return result;
+}
+
+template<typename Op, typename T, typename A>
+auto binary(const dynvector<T, A>& lhs, const dynvector<T, A>& rhs)
+{
+    const auto n = std::min(lhs.size(), rhs.size());
+    return loop_op<T>(n, lhs.values.get_allocator(), [&](size_t i) { return T(Op{}(lhs[i], rhs[i])); });
+}
+
+template<typename Op, typename T, typename A>
+auto binary(const dynvector<T, A>& lhs, const T& rhs)
+{
+    return loop_op<T>(lhs.size(), lhs.values.get_allocator(), [&](size_t i) { return T(Op{}(lhs[i], rhs)); });
+}
+
+template<typename Op, typename T, typename A>
+auto binary(const T& lhs, const dynvector<T, A>& rhs)
+{
+    return loop_op<T>(rhs.size(), rhs.values.get_allocator(), [&](size_t i) { return T(Op{}(lhs, rhs[i])); });
+}
+
+#define dynvector_arithmetic_op(op, func) \
+template<typename T, typename A> \
+auto operator op(const dynvector<T, A>& lhs, const dynvector<T, A>& rhs) \
+{ \
+    return binary<func>(lhs, rhs); \
+} \
+template<typename T, typename A> \
+auto operator op(const dynvector<T, A>& lhs, const std::type_identity_t<T>& rhs) \
+{ \
+    return binary<func>(lhs, rhs); \
+} \
+template<typename T, typename A> \
+auto operator op(const std::type_identity_t<T>& lhs, const dynvector<T, A>& rhs) \
+{ \
+    return binary<func>(lhs, rhs); \
+} \
+template<typename T, typename A> \
+auto operator op##=(dynvector<T, A>& lhs, const dynvector<T, A>& rhs) \
+{ \
+    const auto n = std::min(lhs.size(), rhs.size()); \
+    simd::apply_n(lhs.data(), n, [&](size_t i) { return T(func{}(lhs[i], rhs[i])); }); \
+} \
+template<typename T, typename A> \
+auto operator op##=(dynvector<T, A>& lhs, const std::type_identity_t<T>& rhs) \
+{ \
+    simd::apply_n(lhs.data(), lhs.size(), [&](size_t i) { return T(func{}(lhs[i], rhs)); }); \
+}
+
+dynvector_arithmetic_op(+, std::plus<void>)
+dynvector_arithmetic_op(-, std::minus<void>)
+dynvector_arithmetic_op(*, std::multiplies<void>)
+dynvector_arithmetic_op(/, std::divides<void>)
+
+#undef dynvector_arithmetic_op
+
+template<typename T, typename A>
+auto operator-(const dynvector<T, A>& v)
+{
+    return loop_op<T>(v.size(), v.values.get_allocator(), [&](size_t i) { return T(-v[i]); });
+}
+
+template<typename T, typename A>
+auto dot(const dynvector<T, A>& a, const dynvector<T, A>& b)
+{
+    const auto result = simd::dot_n(a.data(), b.data(), std::min(a.size(), b.size()));
+    return result;
+}
+
+template<typename T, typename A>
+auto length_squared(const dynvector<T, A>& a)
+{
+    const auto result = dot(a, a);
+    return result;
+}
+
+template<typename T, typename A>
+auto length(const dynvector<T, A>& a)
+{
+    const auto result = std::sqrt(length_squared(a));
+    return result;
+}
+
+template<typename T, typename A>
+auto distance_squared(const dynvector<T, A>& a, const dynvector<T, A>& b)
+{
+    const auto result = length_squared(a - b);
+    return result;
+}
+
+template<typename T, typename A>
+auto distance(const dynvector<T, A>& a, const dynvector<T, A>& b)
+{
+    const auto result = std::sqrt(distance_squared(a, b));
+    return result;
+}
+
+template<typename T, typename A>
+auto normalize(const dynvector<T, A>& a)
+{
+    const auto result = a / length(a);
+    return result;
+}
+
+template<typename T, typename A>
+auto min(const dynvector<T, A>& a, const dynvector<T, A>& b)
+{
+    const auto n = std::min(a.size(), b.size());
+    return loop_op<T>(n, a.values.get_allocator(), [&](size_t i) { return std::min(a[i], b[i]); });
+}
+
+template<typename T, typename A>
+auto max(const dynvector<T, A>& a, const dynvector<T, A>& b)
+{
+    const auto n = std::min(a.size(), b.size());
+    return loop_op<T>(n, a.values.get_allocator(), [&](size_t i) { return std::max(a[i], b[i]); });
+}
+
+template<typename T, typename A>
+auto min(const dynvector<T, A>& a, const std::type_identity_t<T>& b)
+{
+    return loop_op<T>(a.size(), a.values.get_allocator(), [&](size_t i) { return std::min(a[i], b); });
+}
+
+template<typename T, typename A>
+auto max(const dynvector<T, A>& a, const std::type_identity_t<T>& b)
+{
+    return loop_op<T>(a.size(), a.values.get_allocator(), [&](size_t i) { return std::max(a[i], b); });
+}
+
+// one pass, the generic lerp would make three temporaries
+template<typename X, typename T, typename A>
+auto lerp(const X& x, const dynvector<T, A>& a, const dynvector<T, A>& b)
+{
+    const auto n = std::min(a.size(), b.size());
+    const auto t = T(x);
+    return loop_op<T>(n, a.values.get_allocator(), [&](size_t i) { return (T(1) - t) * a[i] + t * b[i]; });
+}
+
+template<typename T, typename A>
+auto saturate(const dynvector<T, A>& a)
+{
+    return loop_op<T>(a.size(), a.values.get_allocator(), [&](size_t i) { return std::clamp(a[i], T(0), T(1)); });
+}
+
+} // namespace math
+
+#endif /* DYNVECTOR_MATH_H */
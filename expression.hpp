@@ -0,0 +1,258 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef EXPRESSION_MATH_H
+#define EXPRESSION_MATH_H
+
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace math {
+
+// opt-in lazy arithmetic for vectors of any size. lazy(a) starts an
+// expression, operators with a node on either side build nodes instead of
+// vectors, and assigning the root to a vector or evaluating it into a span
+// runs one fused loop with no temporaries, lazy(a) * s + b - c
+//
+// nodes hold pointers to their operands, evaluate them within the statement
+// that built them. A span of vectors is one flat run of components, nodes
+// are as long as their shortest operand
+
+template<typename T, size_t N>
+struct lazy_operand {
+    using value_type = T;
+    static constexpr size_t components = N;
+    static constexpr bool lazy = true;
+
+    constexpr auto operator[](size_t i) const
+    {
+        return p[i];
+    }
+
+    constexpr auto size() const
+    {
+        return count * N;
+    }
+
+    const T* p;
+    size_t count;
+};
+
+// scalars have no components and fit any length
+template<typename T>
+struct lazy_scalar {
+    using value_type = T;
+    static constexpr size_t components = 0;
+    static constexpr bool lazy = true;
+
+    constexpr auto operator[](size_t) const
+    {
+        return t;
+    }
+
+    constexpr auto size() const
+    {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    T t;
+};
+
+template<typename Op, vector_expression L, vector_expression R>
+struct lazy_binary {
+    static_assert(std::is_same_v<typename L::value_type, typename R::value_type>);
+    static_assert(L::components == R::components || L::components == 0 || R::components == 0);
+
+    using value_type = typename L::value_type;
+    static constexpr size_t components = std::max(L::components, R::components);
+    static constexpr bool lazy = true;
+
+    constexpr auto operator[](size_t i) const
+    {
+        return value_type(Op{}(l[i], r[i]));
+    }
+
+    constexpr auto size() const
+    {
+        return std::min(l.size(), r.size());
+    }
+
+    L l;
+    R r;
+};
+
+template<vector_expression E>
+struct lazy_negate {
+    using value_type = typename E::value_type;
+    static constexpr size_t components = E::components;
+    static constexpr bool lazy = true;
+
+    constexpr auto operator[](size_t i) const
+    {
+        return value_type(-e[i]);
+    }
+
+    constexpr auto size() const
+    {
+        return e.size();
+    }
+
+    E e;
+};
+
+template<typename T, size_t N>
+constexpr auto lazy(const vector<T, N>& a)
+{
+    static_assert(sizeof(vector<T, N>) == N * sizeof(T));
+    const lazy_operand<T, N> result{ &a[0], 1 };
+    return result;
+}
+
+template<typename T, size_t N>
+constexpr auto lazy(std::span<const vector<T, N>> a)
+{
+    static_assert(sizeof(vector<T, N>) == N * sizeof(T));
+    const lazy_operand<T, N> result{ reinterpret_cast<const T*>(a.data()), a.size() };
+    return result;
+}
+
+template<typename T, size_t N>
+constexpr auto lazy(std::span<vector<T, N>> a)
+{
+    return lazy(std::span<const vector<T, N>>(a));
+}
+
+template<vector_expression E>
+constexpr auto lazy(const E& e)
+{
+    return e;
+}
+
+// the other side of a node, scalars take the value type of the node
+template<typename T, typename U>
+constexpr auto lazy_as(const U& u)
+{
+    if constexpr (math_scalar<U>)
+        return lazy_scalar<T>{ T(u) };
+    else
+        return lazy(u);
+}
+
+template<typename T>
+concept lazy_side = math_scalar<T> || requires(const T& t) { lazy(t); };
+
+template<typename L, typename R>
+concept lazy_pair = lazy_side<L> && lazy_side<R> && (vector_expression<L> || vector_expression<R>);
+
+template<typename Op, typename L, typename R>
+constexpr auto lazy_node(const L& l, const R& r)
+{
+    if constexpr (vector_expression<L>) {
+        using T = typename L::value_type;
+        using U = decltype(lazy_as<T>(r));
+        return lazy_binary<Op, L, U>{ l, lazy_as<T>(r) };
+    }
+    else {
+        using T = typename R::value_type;
+        using U = decltype(lazy_as<T>(l));
+        return lazy_binary<Op, U, R>{ lazy_as<T>(l), r };
+    }
+}
+
+template<typename L, typename R>
+    requires lazy_pair<L, R>
+constexpr auto operator+(const L& l, const R& r)
+{
+    return lazy_node<std::plus<void>>(l, r);
+}
+
+template<typename L, typename R>
+    requires lazy_pair<L, R>
+constexpr auto operator-(const L& l, const R& r)
+{
+    return lazy_node<std::minus<void>>(l, r);
+}
+
+template<typename L, typename R>
+    requires lazy_pair<L, R>
+constexpr auto operator*(const L& l, const R& r)
+{
+    return lazy_node<std::multiplies<void>>(l, r);
+}
+
+template<typename L, typename R>
+    requires lazy_pair<L, R>
+constexpr auto operator/(const L& l, const R& r)
+{
+    return lazy_node<std::divides<void>>(l, r);
+}
+
+template<vector_expression E>
+constexpr auto operator-(const E& e)
+{
+    return lazy_negate<E>{ e };
+}
+
+template<math_vector T, vector_expression E>
+constexpr auto operator+=(T& lhs, const E& rhs)
+{
+    lhs = lazy(lhs) + rhs;
+}
+
+template<math_vector T, vector_expression E>
+constexpr auto operator-=(T& lhs, const E& rhs)
+{
+    lhs = lazy(lhs) - rhs;
+}
+
+template<math_vector T, vector_expression E>
+constexpr auto operator*=(T& lhs, const E& rhs)
+{
+    lhs = lazy(lhs) * rhs;
+}
+
+template<math_vector T, vector_expression E>
+constexpr auto operator/=(T& lhs, const E& rhs)
+{
+    lhs = lazy(lhs) / rhs;
+}
+
+// writes min(out.size(), e.size() / N) vectors, out may alias the operands
+template<typename T, size_t N, vector_expression E>
+    requires(E::components == N)
+auto evaluate(std::span<vector<T, N>> out, const E& e)
+{
+    static_assert(sizeof(vector<T, N>) == N * sizeof(T));
+    const auto count = std::min(out.size() * N, e.size() / N * N);
+    auto* p = reinterpret_cast<T*>(out.data());
+    for (size_t i = 0; i < count; i++)
+        p[i] = e[i];
+}
+
+} // namespace math
+
+#endif /* EXPRESSION_MATH_H */
@@ -0,0 +1,343 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include "simd.hpp"
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+namespace math {
+namespace fast {
+
+// polynomial transcendentals on the lanes of simd::pack, and on scalars
+// that run the same kernel in a single lane. Nothing calls into libm, so
+// the kernels inline into the loops around them. Largest error in ulp
+// against a long double reference over the sampled range:
+//
+//                float  double  range
+//   sin, cos       2.4     1.5  |x| < 1e5
+//   acos           2.9     4.1  [-1, 1]
+//   asin           3.5     2.4  [-1, 1]
+//   atan2          2.8     1.6  all finite y, x
+//   exp            1.0     0.9  [-87.3, 88.3], [-708.3, 709.4]
+//   log            2.0     2.0  positive x
+//   rsqrt          3.8     2.5  positive normal x
+//
+// simd::fmadd is only fused on targets with fma, the bounds above are for
+// those. Without it the polynomial tails add up to half an ulp (double acos
+// 4.6) and float sin and cos hold their bound only to |x| < 8192.
+// exp turns to infinity above its range and to zero below it. exp and log
+// pass nan through, the clamp of exp alone would make it a bound. sin and
+// atan2 do not keep the sign of a zero. rsqrt refines a hardware estimate
+// where the lanes have one, and is nan for 0 and infinity there
+
+template<typename T, size_t W>
+inline auto sin(const simd::pack<T, W>& x)
+{
+    return simd::sin(x);
+}
+
+template<typename T, size_t W>
+inline auto cos(const simd::pack<T, W>& x)
+{
+    return simd::cos(x);
+}
+
+// one range reduction and one evaluation of each series for both
+template<typename T, size_t W>
+inline auto sincos(const simd::pack<T, W>& x)
+{
+    using lane = simd::pack<T, W>;
+    const auto [r, q] = simd::reduce_half_pi(x);
+    const auto sr = simd::sin_reduced(r);
+    const auto cr = simd::cos_reduced(r);
+    return std::make_pair(simd::place_quadrant(q, sr, cr), simd::place_quadrant(q + lane(T(1)), sr, cr));
+}
+
+template<typename T, size_t W>
+inline auto acos(const simd::pack<T, W>& x)
+{
+    return simd::acos(x);
+}
+
+// atan of |t| up to tan(pi/8) for float and 0.66 for double, the Cephes
+// polynomial and rational approximations
+template<typename T, size_t W>
+inline auto atan_reduced(const simd::pack<T, W>& t)
+{
+    const auto z = t * t;
+    if constexpr (std::is_same_v<T, float>) {
+        constexpr std::array<T, 4> c{ -3.33329491539e-1f, 1.99777106478e-1f, -1.38776856032e-1f, 8.05374449538e-2f };
+        return simd::fmadd(t * z, simd::horner(z, c), t);
+    }
+    else {
+        constexpr std::array<T, 5> p{ -6.485021904942025371773e1, -1.228866684490136173410e2, -7.500855792314704667340e1,
+                                      -1.615753718733365076637e1, -8.750608600031904122785e-1 };
+        constexpr std::array<T, 6> q{ 1.945506571482613964425e2, 4.853903996359136964868e2, 4.328810604912902668951e2,
+                                      1.650270098316988542046e2, 2.485846490142306297962e1, 1. };
+        return simd::fmadd(t * z, simd::horner(z, p) / simd::horner(z, q), t);
+    }
+}
+
+// the smaller of |y| and |x| over the larger lands in [0, 1], above the
+// reduced range atan(a) = pi/4 + atan((a - 1) / (a + 1)) keeps one divide
+// per lane. The octant of (x, y) then places the angle
+template<typename T, size_t W>
+inline auto atan2(const simd::pack<T, W>& y, const simd::pack<T, W>& x)
+{
+    using lane = simd::pack<T, W>;
+    constexpr auto reduced = std::is_same_v<T, float> ? T(0.41421356237309504880) : T(0.66);
+    const auto ay = simd::abs(y);
+    const auto ax = simd::abs(x);
+    const auto lo = simd::min(ay, ax);
+    const auto hi = simd::max(ay, ax);
+    const auto upper = lo > hi * lane(reduced);
+    const auto num = simd::select(upper, lo - hi, lo);
+    const auto den = simd::select(upper, lo + hi, hi);
+    const auto t = num / simd::select(hi == lane(T(0)), lane(T(1)), den);
+    auto r = atan_reduced(t) + simd::select(upper, lane(std::numbers::pi_v<T> / 4), lane(T(0)));
+    r = simd::select(ay > ax, lane(std::numbers::pi_v<T> / 2) - r, r);
+    r = simd::select(x < lane(T(0)), lane(std::numbers::pi_v<T>) - r, r);
+    const auto result = simd::select(y < lane(T(0)), -r, r);
+    return result;
+}
+
+template<typename T, size_t W>
+inline auto atan(const simd::pack<T, W>& x)
+{
+    return atan2(x, simd::pack<T, W>(T(1)));
+}
+
+// through atan2, which stays accurate near 0 where pi/2 - acos(x) cancels
+template<typename T, size_t W>
+inline auto asin(const simd::pack<T, W>& x)
+{
+    using lane = simd::pack<T, W>;
+    const auto c = simd::sqrt((lane(T(1)) - x) * (lane(T(1)) + x));
+    return atan2(x, c);
+}
+
+// x = k ln 2 + r with |r| <= ln(2) / 2, ln 2 split so k ln 2 is exact, a
+// Taylor series through r^7 for float and r^13 for double, then 2^k goes
+// into the exponent
+template<typename T, size_t W>
+inline auto exp(const simd::pack<T, W>& x)
+{
+    using lane = simd::pack<T, W>;
+    constexpr auto is_float = std::is_same_v<T, float>;
+    constexpr auto lo = is_float ? T(-87.3365) : T(-708.3964);
+    constexpr auto hi = is_float ? T(88.3762) : T(709.4361);
+    constexpr auto ln2_hi = is_float ? T(0.693359375) : T(6.93145751953125e-1);
+    constexpr auto ln2_lo = is_float ? T(-2.12194440e-4) : T(1.42860682030941723212e-6);
+    const auto xc = simd::min(lane(hi), simd::max(lane(lo), x));
+    const auto k = simd::round_nearest(xc * lane(std::numbers::log2e_v<T>));
+    const auto r = simd::fmadd(k, lane(-ln2_lo), simd::fmadd(k, lane(-ln2_hi), xc));
+    lane p;
+    if constexpr (is_float) {
+        constexpr std::array<T, 8> c{ 1.f, 1.f, 1.f / 2.f, 1.f / 6.f, 1.f / 24.f, 1.f / 120.f, 1.f / 720.f, 1.f / 5040.f };
+        p = simd::horner(r, c);
+    }
+    else {
+        constexpr std::array<T, 14> c{ 1., 1., 1. / 2., 1. / 6., 1. / 24., 1. / 120., 1. / 720., 1. / 5040., 1. / 40320.,
+                                       1. / 362880., 1. / 3628800., 1. / 39916800., 1. / 479001600., 1. / 6227020800. };
+        p = simd::horner(r, c);
+    }
+    const auto e = simd::ldexp(p, k);
+    const auto bounded = simd::select(x > lane(hi), lane(std::numeric_limits<T>::infinity()),
+                                      simd::select(x < lane(lo), lane(T(0)), e));
+    const auto result = simd::select(x == x, bounded, x);
+    return result;
+}
+
+// x = m 2^e with m in [sqrt(1/2), sqrt(2)), log(m) = 2 atanh(s) for
+// s = (m - 1) / (m + 1), an odd series in |s| <= 0.172 through s^9 for
+// float and s^21 for double. Subnormal x are scaled up first, zero,
+// negative, infinite and nan lanes are patched in at the end
+template<typename T, size_t W>
+inline auto log(const simd::pack<T, W>& x)
+{
+    using lane = simd::pack<T, W>;
+    using limits = std::numeric_limits<T>;
+    constexpr auto is_float = std::is_same_v<T, float>;
+    constexpr auto ln2_hi = is_float ? T(0.693359375) : T(6.93145751953125e-1);
+    constexpr auto ln2_lo = is_float ? T(-2.12194440e-4) : T(1.42860682030941723212e-6);
+    const auto subnormal = x < lane(limits::min());
+    const auto scaled = simd::select(subnormal, x * lane(T(uint64_t(1) << limits::digits)), x);
+    const auto [m0, e0] = simd::split_exponent(scaled);
+    const auto above = m0 > lane(std::numbers::sqrt2_v<T>);
+    const auto m = simd::select(above, m0 * lane(T(.5)), m0);
+    const auto e1 = simd::select(above, e0 + lane(T(1)), e0);
+    const auto e = simd::select(subnormal, e1 - lane(T(limits::digits)), e1);
+    const auto f = m - lane(T(1));
+    const auto s = f / (f + lane(T(2)));
+    const auto s2 = s * s;
+    lane p;
+    if constexpr (is_float) {
+        constexpr std::array<T, 4> c{ 1.f / 3.f, 1.f / 5.f, 1.f / 7.f, 1.f / 9.f };
+        p = simd::horner(s2, c);
+    }
+    else {
+        constexpr std::array<T, 10> c{ 1. / 3., 1. / 5., 1. / 7., 1. / 9., 1. / 11., 1. / 13., 1. / 15., 1. / 17., 1. / 19., 1. / 21. };
+        p = simd::horner(s2, c);
+    }
+    const auto s1 = s + s;
+    const auto log_m = simd::fmadd(s1 * s2, p, s1);
+    auto r = simd::fmadd(e, lane(ln2_hi), simd::fmadd(e, lane(ln2_lo), log_m));
+    r = simd::select(x == lane(limits::infinity()), x, r);
+    r = simd::select(x < lane(T(0)), lane(limits::quiet_NaN()), r);
+    r = simd::select(x == lane(T(0)), lane(-limits::infinity()), r);
+    const auto result = simd::select(x == x, r, x);
+    return result;
+}
+
+template<typename T, size_t W>
+inline auto rsqrt(const simd::pack<T, W>& x)
+{
+    return simd::rsqrt(x);
+}
+
+// scalars run the lane kernels in a pack of one
+
+template<std::floating_point T>
+auto sin(const T& x)
+{
+    const auto result = fast::sin(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto cos(const T& x)
+{
+    const auto result = fast::cos(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto sincos(const T& x)
+{
+    const auto [s, c] = fast::sincos(simd::pack<T, 1>(x));
+    return std::make_pair(s[0], c[0]);
+}
+
+template<std::floating_point T>
+auto acos(const T& x)
+{
+    const auto result = fast::acos(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto asin(const T& x)
+{
+    const auto result = fast::asin(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto atan(const T& x)
+{
+    const auto result = fast::atan(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto atan2(const T& y, const T& x)
+{
+    const auto result = fast::atan2(simd::pack<T, 1>(y), simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto exp(const T& x)
+{
+    const auto result = fast::exp(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto log(const T& x)
+{
+    const auto result = fast::log(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+template<std::floating_point T>
+auto rsqrt(const T& x)
+{
+    const auto result = fast::rsqrt(simd::pack<T, 1>(x))[0];
+    return result;
+}
+
+} // namespace fast
+
+// the transcendentals behind rotation, from_euler, to_euler, slerp and the
+// angle helpers of utils.hpp, passed as a trailing tag argument that
+// defaults to precise_policy, rotation(axis, angle, fast_policy{}).
+// precise_policy is the standard library, fast_policy the kernels above
+struct precise_policy {
+    template<typename T>
+    static auto sin(const T& x) { return std::sin(x); }
+
+    template<typename T>
+    static auto cos(const T& x) { return std::cos(x); }
+
+    template<typename T>
+    static auto sincos(const T& x) { return std::make_pair(std::sin(x), std::cos(x)); }
+
+    template<typename T>
+    static auto acos(const T& x) { return std::acos(x); }
+
+    template<typename T>
+    static auto asin(const T& x) { return std::asin(x); }
+
+    template<typename T>
+    static auto atan2(const T& y, const T& x) { return std::atan2(y, x); }
+};
+
+struct fast_policy {
+    template<typename T>
+    static auto sin(const T& x) { return fast::sin(x); }
+
+    template<typename T>
+    static auto cos(const T& x) { return fast::cos(x); }
+
+    template<typename T>
+    static auto sincos(const T& x) { return fast::sincos(x); }
+
+    template<typename T>
+    static auto acos(const T& x) { return fast::acos(x); }
+
+    template<typename T>
+    static auto asin(const T& x) { return fast::asin(x); }
+
+    template<typename T>
+    static auto atan2(const T& y, const T& x) { return fast::atan2(y, x); }
+};
+
+} // namespace math
+
+#endif /* FAST_MATH_H */
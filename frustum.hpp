@@ -0,0 +1,250 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef FRUSTUM_MATH_H
+#define FRUSTUM_MATH_H
+
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "bounds.hpp"
+#include "utils.hpp"
+#include "simd.hpp"
+#include "vector_soa.hpp"
+#include "transform.hpp"
+#include "thread_pool.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <span>
+
+namespace math {
+
+// six inward facing planes, left right bottom top near far, taken from the
+// rows of a view-projection matrix that maps points to clip space the way
+// mul(vector<T, 4>(p, 1), m) does. The box and sphere tests are
+// conservative, shapes outside but close to an edge of the frustum may pass
+template<typename T>
+struct frustum {
+    static constexpr size_t parallel_threshold = size_t(1) << 16;
+
+    frustum() = default;
+
+    frustum(const matrix<T, 4, 4>& m)
+    {
+        const auto row = [&](size_t i) { return vector<T, 4>(m[i], m[4 + i], m[8 + i], m[12 + i]); };
+        const std::array<vector<T, 4>, 6> e{ row(3) + row(0), row(3) - row(0),
+                                             row(3) + row(1), row(3) - row(1),
+                                             row(3) + row(2), row(3) - row(2) };
+        for (size_t i = 0; i < 6; i++) {
+            const vector<T, 3> n(e[i].x, e[i].y, e[i].z);
+            const auto s = T(1) / length(n);
+            planes[i].normal = n * s;
+            planes[i].d = e[i].w * s;
+        }
+    }
+
+    auto contains(const vector<T, 3>& p) const
+    {
+        for (const auto& plane : planes)
+            if (plane.distance(p) < T(0))
+                return false;
+        return true;
+    }
+
+    auto intersects(const vector<T, 3>& center, const T& radius) const
+    {
+        for (const auto& plane : planes)
+            if (plane.distance(center) < -radius)
+                return false;
+        return true;
+    }
+
+    // tests the corner furthest along each plane normal, without early outs
+    // as boxes straddling the view make the branches unpredictable
+    auto intersects(const bounds<T, 3>& b) const
+    {
+        bool result = true;
+        for (const auto& plane : planes) {
+            const auto& n = plane.normal;
+            const vector<T, 3> p(n.x > T(0) ? b.max.x : b.min.x,
+                                 n.y > T(0) ? b.max.y : b.min.y,
+                                 n.z > T(0) ? b.max.z : b.min.z);
+            result &= plane.distance(p) >= T(0);
+        }
+        return result;
+    }
+
+    // oriented box, b in the local space of an affine model matrix
+    auto intersects(const bounds<T, 3>& b, const matrix<T, 4, 4>& model) const
+    {
+        const auto c = mul(vector<T, 4>(b.center(), T(1)), model);
+        const auto e = b.volume() * T(.5);
+        const std::array<vector<T, 3>, 3> axes{ vector<T, 3>(model.x.x, model.x.y, model.x.z) * e.x,
+                                                vector<T, 3>(model.y.x, model.y.y, model.y.z) * e.y,
+                                                vector<T, 3>(model.z.x, model.z.y, model.z.z) * e.z };
+        for (const auto& plane : planes) {
+            const auto r = std::abs(dot(plane.normal, axes[0])) +
+                           std::abs(dot(plane.normal, axes[1])) +
+                           std::abs(dot(plane.normal, axes[2]));
+            if (plane.distance(vector<T, 3>(c.x, c.y, c.z)) < -r)
+                return false;
+        }
+        return true;
+    }
+
+    // bit i of visible[i / 64] is set when box i intersects, whole words are
+    // written and boxes past visible.size() * 64 are skipped. Large spans
+    // are split into word ranges culled on the thread pool
+    auto cull(std::span<const bounds<T, 3>> boxes, std::span<uint64_t> visible) const
+    {
+        const auto k = broadcast();
+        const auto words = std::min(visible.size(), (boxes.size() + 63) / 64);
+        parallel_for(words, parallel_threshold / 64, [&](size_t first, size_t last) {
+            cull(k, boxes, visible, first, last);
+        });
+    }
+
+    // writes the indices of intersecting boxes in order until indices is
+    // full, returns how many were written
+    auto cull(std::span<const bounds<T, 3>> boxes, std::span<uint32_t> indices) const
+    {
+        const auto k = broadcast();
+        size_t result = 0;
+        for (size_t i = 0; i < boxes.size() && result < indices.size(); i += 64) {
+            auto bits = mask(k, boxes.subspan(i, std::min<size_t>(64, boxes.size() - i)));
+            for (; bits != 0 && result < indices.size(); bits &= bits - 1)
+                indices[result++] = uint32_t(i + std::countr_zero(bits));
+        }
+        return result;
+    }
+
+    std::array<plane<T>, 6> planes;
+
+private:
+    // packets hold the min and max corners of batch_width / 2 boxes in
+    // alternating lanes, so a span of boxes loads as a span of corners
+    static constexpr size_t W = batch_width<T>;
+    using lane = simd::pack<T, W>;
+
+    static_assert(sizeof(bounds<T, 3>) == 2 * sizeof(vector<T, 3>));
+
+    // per plane and axis the weight of the min corner in even lanes and of
+    // the max corner in odd lanes, only the one along the normal is kept
+    struct weights {
+        std::array<std::array<lane, 3>, 6> n;
+        std::array<lane, 6> d;
+    };
+
+    auto broadcast() const
+    {
+        weights result;
+        if constexpr (W > 1) {
+            for (size_t p = 0; p < 6; p++) {
+                std::array<T, W> d{};
+                for (size_t i = 0; i < W; i += 2)
+                    d[i] = planes[p].d;
+                result.d[p] = lane(d);
+                for (size_t a = 0; a < 3; a++) {
+                    const auto n = planes[p].normal[a];
+                    std::array<T, W> w;
+                    for (size_t i = 0; i < W; i += 2) {
+                        w[i] = n > T(0) ? T(0) : n;
+                        w[i + 1] = n > T(0) ? n : T(0);
+                    }
+                    result.n[p][a] = lane(w);
+                }
+            }
+        }
+        return result;
+    }
+
+    static auto swap_pairs(const lane& v)
+    {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return simd::shuffle<(I ^ 1)...>(v);
+        }(std::make_index_sequence<W>{});
+    }
+
+    // keeps the even bits of m, packed down
+    static auto even_bits(uint32_t m)
+    {
+        m &= 0x55555555u;
+        m = (m | (m >> 1)) & 0x33333333u;
+        m = (m | (m >> 2)) & 0x0f0f0f0fu;
+        m = (m | (m >> 4)) & 0x00ff00ffu;
+        m = (m | (m >> 8)) & 0x0000ffffu;
+        return m;
+    }
+
+    // visibility bits of up to 64 boxes
+    auto mask(const weights& k, std::span<const bounds<T, 3>> boxes) const
+    {
+        uint64_t result = 0;
+        if constexpr (W == 1) {
+            // plane by plane so the box loop is left to the auto-vectorizer
+            const auto* v = reinterpret_cast<const T*>(boxes.data());
+            std::array<uint8_t, 64> inside;
+            inside.fill(1);
+            for (const auto& plane : planes) {
+                const auto& n = plane.normal;
+                const auto x = n.x > T(0) ? 3 : 0, y = n.y > T(0) ? 4 : 1, z = n.z > T(0) ? 5 : 2;
+                for (size_t i = 0; i < boxes.size(); i++) {
+                    const auto* b = v + i * 6;
+                    inside[i] &= n.x * b[x] + n.y * b[y] + n.z * b[z] + plane.d >= T(0);
+                }
+            }
+            for (size_t i = 0; i < boxes.size(); i++)
+                result |= uint64_t(inside[i]) << i;
+        }
+        else {
+            constexpr auto B = W / 2;
+            const std::span corners(reinterpret_cast<const vector<T, 3>*>(boxes.data()), boxes.size() * 2);
+            for (size_t i = 0; i < boxes.size(); i += B) {
+                const auto c = vector_soa<T, 3, W>::load(corners.subspan(i * 2, std::min(W, corners.size() - i * 2)));
+                auto inside = simd::mask<T, W>{};
+                for (size_t p = 0; p < 6; p++) {
+                    const auto& n = k.n[p];
+                    const auto s = simd::fmadd(n[2], c[2], simd::fmadd(n[1], c[1], simd::fmadd(n[0], c[0], k.d[p])));
+                    const auto hit = s + swap_pairs(s) >= lane(T(0));
+                    inside = p == 0 ? hit : inside & hit;
+                }
+                result |= uint64_t(even_bits(simd::bitmask(inside))) << i;
+            }
+            if (boxes.size() < 64)
+                result &= (uint64_t(1) << boxes.size()) - 1;
+        }
+        return result;
+    }
+
+    auto cull(const weights& k, std::span<const bounds<T, 3>> boxes, std::span<uint64_t> visible, size_t first, size_t last) const
+    {
+        for (size_t w = first; w < last; w++)
+            visible[w] = mask(k, boxes.subspan(w * 64, std::min<size_t>(64, boxes.size() - w * 64)));
+    }
+};
+
+using frustumf = frustum<float>;
+using frustumd = frustum<double>;
+
+} // namespace math
+
+#endif /* FRUSTUM_MATH_H */
@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HIERARCHY_MATH_H
+#define HIERARCHY_MATH_H
+
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "affine.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace math {
+
+// world transforms of a forest of nodes, kept in parallel arrays in
+// topological order so every parent comes before its children. update()
+// recomputes the nodes whose local transform changed and everything below
+// them, worlds holds the results contiguously in node order
+template<typename T>
+struct hierarchy {
+    static constexpr uint32_t root = ~uint32_t(0);
+    // depth levels with more dirty nodes than this are split over the thread pool
+    static constexpr size_t parallel_threshold = size_t(1) << 14;
+
+    hierarchy() = default;
+
+    // parent is an existing node or root, returns the index of the new node
+    auto add(uint32_t parent, const matrix<T, 4, 4>& local)
+    {
+        const auto result = uint32_t(parents.size());
+        parents.push_back(parent);
+        depths.push_back(parent == root ? 0 : depths[parent] + 1);
+        locals.push_back(local);
+        worlds.push_back(local);
+        dirty.push_back(1);
+        return result;
+    }
+
+    auto add(uint32_t parent, const affine<T>& local)
+    {
+        return add(parent, to_matrix(local));
+    }
+
+    auto set_local(uint32_t i, const matrix<T, 4, 4>& local)
+    {
+        locals[i] = local;
+        dirty[i] = 1;
+    }
+
+    auto set_local(uint32_t i, const affine<T>& local)
+    {
+        set_local(i, to_matrix(local));
+    }
+
+    auto size() const
+    {
+        return parents.size();
+    }
+
+    // a forward pass pushes dirt down and composes in node order, which
+    // streams memory. With several cores and at least parallel_threshold
+    // dirty nodes they are bucketed by depth instead, nodes at one depth only
+    // read worlds of the level above so every level is split over tasks
+    auto update()
+    {
+        if (parents.size() < parallel_threshold || thread_pool::global().size() < 2) {
+            for (size_t i = 0; i < parents.size(); i++) {
+                const auto p = parents[i];
+                if (p != root)
+                    dirty[i] |= dirty[p];
+                if (dirty[i])
+                    compose(uint32_t(i));
+            }
+        }
+        else
+            update_levels();
+        std::fill(dirty.begin(), dirty.end(), uint8_t(0));
+    }
+
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> depths;
+    std::vector<matrix<T, 4, 4>> locals;
+    std::vector<matrix<T, 4, 4>> worlds;
+    std::vector<uint8_t> dirty;
+
+  private:
+    auto update_levels()
+    {
+        size_t count = 0;
+        uint32_t levels = 0;
+        for (size_t i = 0; i < parents.size(); i++) {
+            if (parents[i] != root)
+                dirty[i] |= dirty[parents[i]];
+            if (dirty[i]) {
+                count++;
+                levels = std::max(levels, depths[i] + 1);
+            }
+        }
+        if (count < parallel_threshold) {
+            for (size_t i = 0; i < parents.size(); i++)
+                if (dirty[i])
+                    compose(uint32_t(i));
+            return;
+        }
+        offsets.assign(levels + 1, 0);
+        for (size_t i = 0; i < parents.size(); i++)
+            if (dirty[i])
+                offsets[depths[i] + 1]++;
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        order.resize(offsets.back());
+        for (size_t i = 0; i < parents.size(); i++)
+            if (dirty[i])
+                order[offsets[depths[i]]++] = uint32_t(i);
+        // the fill moved every offset to the end of its level
+        for (uint32_t d = 0, first = 0; d < levels; first = offsets[d++])
+            compose(std::span<const uint32_t>(order).subspan(first, offsets[d] - first));
+    }
+
+    auto compose(uint32_t i)
+    {
+        const auto p = parents[i];
+        worlds[i] = p == root ? locals[i] : mul(worlds[p], locals[i]);
+    }
+
+    auto compose(std::span<const uint32_t> nodes)
+    {
+        parallel_for(nodes.size(), parallel_threshold, [&](size_t first, size_t last) {
+            for (size_t n = first; n < last; n++)
+                compose(nodes[n]);
+        });
+    }
+
+    // dirty nodes grouped by depth, offsets[d] ends level d after update
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> offsets;
+};
+
+} // namespace math
+
+#endif /* HIERARCHY_MATH_H */
@@ -0,0 +1,310 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INTERSECT_MATH_H
+#define INTERSECT_MATH_H
+
+#include "vector.hpp"
+#include "vector_soa.hpp"
+#include "simd.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+#include "triangle.hpp"
+#include "utils.hpp"
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+namespace math {
+
+// packet forms test one ray against W primitives and report misses as an
+// infinite distance, scalar forms return an empty optional
+
+// barycentrics weight the second and third vertex, the first gets 1 - u - v
+template<typename T>
+struct triangle_hit {
+    T t;
+    T u;
+    T v;
+};
+
+// W boxes, lanes past the loaded count hold a point at infinity that every ray misses
+template<typename T, size_t W>
+struct bounds_soa {
+    static auto load(std::span<const bounds<T, 3>> src)
+    {
+        constexpr auto far = std::numeric_limits<T>::infinity();
+        std::array<std::array<T, W>, 3> lo, hi;
+        for (auto& c : lo)
+            c.fill(far);
+        for (auto& c : hi)
+            c.fill(far);
+        for (size_t i = 0; i < std::min(W, src.size()); i++) {
+            for (size_t c = 0; c < 3; c++) {
+                lo[c][i] = src[i].min[c];
+                hi[c][i] = src[i].max[c];
+            }
+        }
+        bounds_soa result;
+        for (size_t c = 0; c < 3; c++) {
+            result.min[c] = simd::pack<T, W>(lo[c]);
+            result.max[c] = simd::pack<T, W>(hi[c]);
+        }
+        return result;
+    }
+
+    vector_soa<T, 3, W> min, max;
+};
+
+// W triangles, missing lanes are NaN so every comparison on them fails,
+// a degenerate triangle would not do as contracted edge functions need
+// not cancel to zero
+template<typename T, size_t W>
+struct triangle_soa {
+    static auto load(std::span<const triangle<T>> src)
+    {
+        std::array<std::array<vector<T, 3>, W>, 3> corners;
+        for (auto& c : corners)
+            c.fill(vector<T, 3>(std::numeric_limits<T>::quiet_NaN()));
+        for (size_t i = 0; i < std::min(W, src.size()); i++)
+            for (size_t k = 0; k < 3; k++)
+                corners[k][i] = src[i][k];
+        triangle_soa result;
+        for (size_t k = 0; k < 3; k++)
+            result.v[k] = vector_soa<T, 3, W>::load(corners[k]);
+        return result;
+    }
+
+    std::array<vector_soa<T, 3, W>, 3> v;
+};
+
+// W planes, missing lanes are NaN and never hit
+template<typename T, size_t W>
+struct plane_soa {
+    static auto load(std::span<const plane<T>> src)
+    {
+        std::array<vector<T, 3>, W> normals;
+        std::array<T, W> d;
+        normals.fill(vector<T, 3>(std::numeric_limits<T>::quiet_NaN()));
+        d.fill(std::numeric_limits<T>::quiet_NaN());
+        for (size_t i = 0; i < std::min(W, src.size()); i++) {
+            normals[i] = src[i].normal;
+            d[i] = src[i].d;
+        }
+        plane_soa result;
+        result.normal = vector_soa<T, 3, W>::load(normals);
+        result.d = simd::pack<T, W>(d);
+        return result;
+    }
+
+    vector_soa<T, 3, W> normal;
+    simd::pack<T, W> d;
+};
+
+template<typename T>
+auto inverse_direction(const ray<T, 3>& r)
+{
+    const auto result = T(1) / r.d;
+    return result;
+}
+
+// slab test, returns the entry distance clipped to [tmin, tmax]
+template<typename T>
+std::optional<T> intersect(const ray<T, 3>& r, const vector<T, 3>& inv_d, const bounds<T, 3>& b, T tmin, T tmax)
+{
+    for (size_t a = 0; a < 3; a++) {
+        const auto t0 = (b.min[a] - r.p[a]) * inv_d[a];
+        const auto t1 = (b.max[a] - r.p[a]) * inv_d[a];
+        tmin = std::max(tmin, std::min(t0, t1));
+        tmax = std::min(tmax, std::max(t0, t1));
+    }
+    if (tmin > tmax)
+        return {};
+    return tmin;
+}
+
+template<typename T, size_t W>
+auto intersect(const ray<T, 3>& r, const vector<T, 3>& inv_d, const bounds_soa<T, W>& b, T tmin, T tmax)
+{
+    using lane = simd::pack<T, W>;
+    auto t_near = lane(tmin);
+    auto t_far = lane(tmax);
+    for (size_t a = 0; a < 3; a++) {
+        const auto t0 = (b.min[a] - lane(r.p[a])) * lane(inv_d[a]);
+        const auto t1 = (b.max[a] - lane(r.p[a])) * lane(inv_d[a]);
+        t_near = simd::max(t_near, simd::min(t0, t1));
+        t_far = simd::min(t_far, simd::max(t0, t1));
+    }
+    const auto result = simd::select(t_near <= t_far, t_near, lane(std::numeric_limits<T>::infinity()));
+    return result;
+}
+
+// a * b - c * d such that swapping the products flips the sign exactly,
+// which keeps the edge shared by two triangles watertight. A compiler
+// free to contract may fuse one product and round the other, so targets
+// with fma evaluate both orders explicitly fused and take half the gap
+template<typename T>
+auto difference_of_products(const T& a, const T& b, const T& c, const T& d)
+{
+#if defined(FP_FAST_FMA) && defined(FP_FAST_FMAF)
+    const auto fused = [](const T& x, const T& y, const T& z) {
+        if constexpr (std::is_floating_point_v<T>)
+            return std::fma(x, y, z);
+        else
+            return simd::fmadd(x, y, z);
+    };
+    const auto result = (fused(a, b, -(c * d)) - fused(c, d, -(a * b))) * T(.5);
+#else
+    const auto result = a * b - c * d;
+#endif
+    return result;
+}
+
+// shear and permutation that map the ray onto +z, shared by every
+// triangle tested against it (Woop, Benthin and Wald, JCGT 2013)
+template<typename T>
+struct watertight_ray {
+    explicit watertight_ray(const ray<T, 3>& r) :
+      origin(r.p)
+    {
+        const vector<T, 3> a(std::abs(r.d.x), std::abs(r.d.y), std::abs(r.d.z));
+        kz = a.x > a.y ? (a.x > a.z ? 0 : 2) : (a.y > a.z ? 1 : 2);
+        kx = (kz + 1) % 3;
+        ky = (kx + 1) % 3;
+        if (r.d[kz] < T(0))
+            std::swap(kx, ky);
+        shear = vector<T, 3>(r.d[kx] / r.d[kz], r.d[ky] / r.d[kz], T(1) / r.d[kz]);
+    }
+
+    vector<T, 3> origin;
+    vector<T, 3> shear;
+    size_t kx, ky, kz;
+};
+
+// watertight, edges shared by two triangles never let a ray through
+template<typename T>
+std::optional<triangle_hit<T>> intersect(const watertight_ray<T>& r, const triangle<T>& tri, T tmin, T tmax)
+{
+    const auto a = tri[0] - r.origin;
+    const auto b = tri[1] - r.origin;
+    const auto c = tri[2] - r.origin;
+    const auto ax = a[r.kx] - r.shear.x * a[r.kz];
+    const auto ay = a[r.ky] - r.shear.y * a[r.kz];
+    const auto bx = b[r.kx] - r.shear.x * b[r.kz];
+    const auto by = b[r.ky] - r.shear.y * b[r.kz];
+    const auto cx = c[r.kx] - r.shear.x * c[r.kz];
+    const auto cy = c[r.ky] - r.shear.y * c[r.kz];
+    auto u = difference_of_products(cx, by, cy, bx);
+    auto v = difference_of_products(ax, cy, ay, cx);
+    auto w = difference_of_products(bx, ay, by, ax);
+    // float edge functions of exactly zero are redone in double
+    if constexpr (std::is_same_v<T, float>) {
+        if (u == 0.f || v == 0.f || w == 0.f) {
+            u = float(double(cx) * double(by) - double(cy) * double(bx));
+            v = float(double(ax) * double(cy) - double(ay) * double(cx));
+            w = float(double(bx) * double(ay) - double(by) * double(ax));
+        }
+    }
+    if ((u < T(0) || v < T(0) || w < T(0)) && (u > T(0) || v > T(0) || w > T(0)))
+        return {};
+    const auto det = u + v + w;
+    if (det == T(0))
+        return {};
+    const auto z = u * r.shear.z * a[r.kz] + v * r.shear.z * b[r.kz] + w * r.shear.z * c[r.kz];
+    const auto inv = T(1) / det;
+    const auto t = z * inv;
+    if (!(t > tmin && t < tmax))
+        return {};
+    return triangle_hit<T>{ t, v * inv, w * inv };
+}
+
+template<typename T>
+auto intersect(const ray<T, 3>& r, const triangle<T>& tri, T tmin, T tmax)
+{
+    const auto result = intersect(watertight_ray<T>(r), tri, tmin, tmax);
+    return result;
+}
+
+template<typename T, size_t W>
+auto intersect(const watertight_ray<T>& r, const triangle_soa<T, W>& tri, T tmin, T tmax)
+{
+    using lane = simd::pack<T, W>;
+    const lane zero(T(0));
+    const lane sx(r.shear.x), sy(r.shear.y), sz(r.shear.z);
+    const auto project = [&](const vector_soa<T, 3, W>& p) {
+        const auto x = p[r.kx] - lane(r.origin[r.kx]);
+        const auto y = p[r.ky] - lane(r.origin[r.ky]);
+        const auto z = p[r.kz] - lane(r.origin[r.kz]);
+        return std::array<lane, 3>{ x - sx * z, y - sy * z, sz * z };
+    };
+    const auto a = project(tri.v[0]);
+    const auto b = project(tri.v[1]);
+    const auto c = project(tri.v[2]);
+    const auto u = difference_of_products(c[0], b[1], c[1], b[0]);
+    const auto v = difference_of_products(a[0], c[1], a[1], c[0]);
+    const auto w = difference_of_products(b[0], a[1], b[1], a[0]);
+    const auto inside = ((u >= zero) & (v >= zero) & (w >= zero)) | ((u <= zero) & (v <= zero) & (w <= zero));
+    const auto det = u + v + w;
+    const auto inv = lane(T(1)) / det;
+    const auto t = (u * a[2] + v * b[2] + w * c[2]) * inv;
+    const auto hit = inside & (simd::abs(det) > zero) & (t > lane(tmin)) & (t < lane(tmax));
+    const triangle_hit<lane> result{ simd::select(hit, t, lane(std::numeric_limits<T>::infinity())), v * inv, w * inv };
+    return result;
+}
+
+template<typename T, size_t W>
+auto intersect(const ray<T, 3>& r, const triangle_soa<T, W>& tri, T tmin, T tmax)
+{
+    const auto result = intersect(watertight_ray<T>(r), tri, tmin, tmax);
+    return result;
+}
+
+template<typename T>
+std::optional<T> intersect(const ray<T, 3>& r, const plane<T>& p, T tmin, T tmax)
+{
+    const auto denominator = dot(p.normal, r.d);
+    if (denominator == T(0))
+        return {};
+    const auto t = -p.distance(r.p) / denominator;
+    if (!(t > tmin && t < tmax))
+        return {};
+    return t;
+}
+
+template<typename T, size_t W>
+auto intersect(const ray<T, 3>& r, const plane_soa<T, W>& p, T tmin, T tmax)
+{
+    using lane = simd::pack<T, W>;
+    const vector_soa<T, 3, W> origin(r.p), direction(r.d);
+    const auto denominator = dot(p.normal, direction);
+    const auto t = -(dot(p.normal, origin) + p.d) / denominator;
+    const auto hit = (simd::abs(denominator) > lane(T(0))) & (t > lane(tmin)) & (t < lane(tmax));
+    const auto result = simd::select(hit, t, lane(std::numeric_limits<T>::infinity()));
+    return result;
+}
+
+} // namespace math
+
+#endif /* INTERSECT_MATH_H */
@@ -0,0 +1,812 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// the C++20 module of lucmath, import lucmath; brings in the names of
+// #include "math.hpp". the headers stay in the global module fragment and
+// are only re-exported here, so one program may both include and import
+// lucmath. LUCMATH_SIMD must match between the module and its importers
+module;
+
+#include "math.hpp"
+
+export module lucmath;
+
+export namespace math {
+
+// simd.hpp
+namespace simd {
+using math::simd::native_width;
+using math::simd::pack;
+using math::simd::mask;
+using math::simd::lanewise;
+using math::simd::compare;
+using math::simd::operator+;
+using math::simd::operator-;
+using math::simd::operator*;
+using math::simd::operator/;
+using math::simd::min;
+using math::simd::max;
+using math::simd::abs;
+using math::simd::sqrt;
+using math::simd::rsqrt;
+using math::simd::ldexp;
+using math::simd::split_exponent;
+using math::simd::fast_fma;
+using math::simd::fmadd;
+using math::simd::operator<;
+using math::simd::operator<=;
+using math::simd::operator>;
+using math::simd::operator>=;
+using math::simd::operator&;
+using math::simd::operator|;
+using math::simd::bitmask;
+using math::simd::select;
+using math::simd::reduce_add;
+using math::simd::reduce_min;
+using math::simd::reduce_max;
+using math::simd::unzip;
+using math::simd::zip;
+using math::simd::shuffle;
+using math::simd::blend;
+using math::simd::interleave_mask;
+using math::simd::interleave_source;
+using math::simd::deinterleave_mask;
+using math::simd::gather_component;
+using math::simd::load_component;
+using math::simd::load_components;
+using math::simd::place_component;
+using math::simd::place_components;
+using math::simd::scatter_register;
+using math::simd::store_registers;
+using math::simd::block_mask;
+using math::simd::block_lane;
+using math::simd::block_source;
+using math::simd::rotate_lanes;
+using math::simd::rotate_registers;
+using math::simd::gather_block;
+using math::simd::load_block;
+using math::simd::load_blocks;
+using math::simd::place_block;
+using math::simd::scatter_block;
+using math::simd::place_blocks;
+using math::simd::store_blocks;
+using math::simd::load_interleaved;
+using math::simd::store_interleaved;
+using math::simd::any;
+using math::simd::all;
+using math::simd::none;
+using math::simd::horner;
+using math::simd::round_nearest;
+using math::simd::reduce_half_pi;
+using math::simd::place_quadrant;
+using math::simd::sin_reduced;
+using math::simd::cos_reduced;
+using math::simd::sin;
+using math::simd::cos;
+using math::simd::acos;
+using math::simd::native_pack;
+using math::simd::apply_n;
+using math::simd::dot_n;
+} // namespace simd
+
+// fast.hpp
+namespace fast {
+using math::fast::sin;
+using math::fast::cos;
+using math::fast::sincos;
+using math::fast::acos;
+using math::fast::atan_reduced;
+using math::fast::atan2;
+using math::fast::atan;
+using math::fast::asin;
+using math::fast::exp;
+using math::fast::log;
+using math::fast::rsqrt;
+} // namespace fast
+using math::precise_policy;
+using math::fast_policy;
+
+// thread_pool.hpp
+using math::thread_pool;
+using math::cache_line;
+using math::cache_line_items;
+using math::chunks_per_thread;
+using math::parallel_for;
+using math::parallel_reduce;
+
+// vector.hpp
+using math::vector_expression;
+using math::vector;
+using math::math_scalar;
+using math::math_vector;
+using math::vector_or_scalar;
+using math::binary_op;
+using math::loop_threshold;
+using math::loop_op;
+using math::binary;
+#if defined(LUCMATH_SIMD)
+using math::simd_register;
+using math::simd_backed;
+using math::simd_loadable;
+using math::simd_lowered;
+using math::simd_load;
+using math::simd_store;
+#endif
+using math::add;
+using math::sub;
+using math::mul;
+using math::div;
+using math::operator+;
+using math::operator-;
+using math::operator*;
+using math::operator/;
+using math::operator+=;
+using math::operator-=;
+using math::operator*=;
+using math::operator/=;
+using math::unary_op;
+using math::unary;
+using math::collapse;
+using math::dot;
+using math::cross;
+using math::length_squared;
+using math::length;
+using math::length_non_zero;
+using math::distance_squared;
+using math::distance;
+using math::distance_non_zero;
+using math::normalize;
+using math::normalized_with_length;
+using math::cast;
+using math::float2;
+using math::float3;
+using math::float4;
+using math::double2;
+using math::double3;
+using math::double4;
+using math::short2;
+using math::short3;
+using math::short4;
+using math::int2;
+using math::int3;
+using math::int4;
+using math::long2;
+using math::long3;
+using math::long4;
+using math::ushort2;
+using math::ushort3;
+using math::ushort4;
+using math::uint2;
+using math::uint3;
+using math::uint4;
+using math::ulong2;
+using math::ulong3;
+using math::ulong4;
+using math::bool2;
+using math::bool3;
+using math::bool4;
+
+// vector_soa.hpp
+using math::vector_soa;
+using math::soa_operand;
+using math::soa_binary;
+using math::min;
+using math::max;
+using math::clamp;
+using math::saturate;
+using math::lerp;
+using math::select;
+using math::float2_soa;
+using math::float3_soa;
+using math::float4_soa;
+using math::double2_soa;
+using math::double3_soa;
+using math::double4_soa;
+
+// matrix.hpp
+using math::identity;
+using math::matrix;
+using math::diagonal_matrix;
+using math::matrix_block;
+using math::matrix_tile;
+using math::mul_blocked;
+using math::mul_tiled;
+using math::scale;
+using math::translation;
+using math::transpose;
+using math::adjugate;
+using math::determinant;
+using math::inverse;
+using math::inverse_orthonormal;
+using math::orthonormalize;
+using math::inverse_rigid;
+using math::inverse_affine;
+using math::look_at;
+using math::perspective;
+using math::orthographic;
+using math::rotation;
+using math::matrix3;
+using math::matrix4;
+using math::matrixd3;
+using math::matrixd4;
+
+// transform.hpp
+using math::batch_width;
+using math::span_in;
+using math::span_out;
+using math::matrix_in;
+using math::matrix_out;
+using math::affine_in;
+using math::affine_out;
+using math::quaternion_in;
+using math::quaternion_out;
+using math::as_vectors;
+using math::broadcast;
+using math::transform_points;
+using math::transform_vectors;
+using math::transform_normals;
+using math::mul_many;
+using math::inverse_many;
+using math::normalize_many;
+using math::rotate_many;
+using math::slerp;
+using math::slerp_many;
+using math::from_euler_many;
+using math::to_euler_many;
+using math::as_dekkers;
+using math::dekker_many;
+using math::add_many;
+using math::sub_many;
+using math::div_many;
+
+// parallel.hpp
+namespace parallel {
+using math::parallel::parallel_bytes;
+using math::parallel::grain;
+using math::parallel::bounds_of;
+using math::parallel::transform_points;
+using math::parallel::mul_many;
+using math::parallel::rotate_many;
+using math::parallel::from_euler_many;
+using math::parallel::to_euler_many;
+} // namespace parallel
+
+// quaternion.hpp
+using math::quaternion;
+using math::transform;
+using math::rotation4;
+using math::rotation3;
+using math::conjugate;
+using math::from_rotation;
+using math::lerp_normalized;
+using math::euler_order;
+using math::euler_axes;
+using math::from_euler;
+using math::to_euler;
+using math::quaternionf;
+using math::quaterniond;
+
+// affine.hpp
+using math::affine;
+using math::to_matrix;
+using math::transform_vector;
+using math::transform_point;
+using math::mul_affine;
+
+// hierarchy.hpp
+using math::hierarchy;
+
+// dual_quaternion.hpp
+using math::dual_quaternion;
+using math::to_affine;
+using math::skin_parallel_threshold;
+using math::skin_chunk;
+using math::skin;
+using math::skin_many;
+using math::dual_quaternionf;
+using math::dual_quaterniond;
+
+// bounds.hpp
+using math::bounds;
+using math::bounds2;
+using math::bounds3;
+using math::bounds4;
+
+// dekker.hpp
+using math::dekker;
+using math::dekker_addition;
+using math::dekker_subtraction;
+using math::dekker_add12;
+using math::dekker_split;
+using math::dekker_mul12_split;
+using math::dekker_mul12_fma;
+using math::dekker_mul12;
+using math::dekker_multiplication;
+using math::dekker_division;
+using math::dekker_soa;
+using math::dekker2;
+using math::dekker3;
+using math::dekker4;
+
+// summation.hpp
+using math::compensated_scalar;
+using math::compensated_parallel_threshold;
+using math::compensated_width;
+using math::compensated_sum;
+using math::reduce_add;
+using math::load_widened;
+using math::sumk_range;
+using math::dotk_range;
+using math::compensated_reduce;
+using math::sumk;
+using math::dotk;
+using math::sum2;
+using math::dot2;
+
+// ray.hpp
+using math::ray;
+using math::along_ray;
+using math::rayf3;
+using math::rayd3;
+
+namespace r2 {
+using math::r2::rayf2;
+using math::r2::rayd2;
+using math::r2::rayi2;
+} // namespace r2
+
+// triangle.hpp
+using math::triangle;
+using math::triangle_center;
+using math::triangle_normal;
+using math::triangle_area;
+using math::triangle_signed_volume;
+
+// bvh.hpp
+using math::bvh_hit;
+using math::half_area;
+using math::bvh;
+using math::bvhf;
+using math::bvhd;
+
+// intersect.hpp
+using math::triangle_hit;
+using math::bounds_soa;
+using math::triangle_soa;
+using math::plane_soa;
+using math::inverse_direction;
+using math::intersect;
+using math::difference_of_products;
+using math::watertight_ray;
+
+// ray_packet.hpp
+using math::ray_packet;
+using math::rayf3_packet4;
+using math::rayf3_packet8;
+using math::intersect_each;
+
+// frustum.hpp
+using math::frustum;
+using math::frustumf;
+using math::frustumd;
+
+// utils.hpp
+using math::map;
+using math::bounded;
+using math::wrap;
+using math::sanitize;
+using math::sign;
+using math::reflect;
+using math::mean;
+using math::face_forward;
+using math::rotate_axis_angle;
+using math::atan2;
+using math::separation_angle;
+using math::vector_angle;
+using math::perpendicular;
+using math::unproject;
+using math::ortho_normalize;
+using math::all_true;
+using math::any_true;
+using math::rotate;
+using math::same_hemisphere;
+using math::ortho_normal_base;
+using math::plane;
+using math::planef;
+using math::planed;
+
+namespace onb {
+using math::onb::cos_theta;
+using math::onb::abs_cos_theta;
+using math::onb::cos_theta_sq;
+using math::onb::sin_theta_sq;
+using math::onb::sin_theta;
+using math::onb::tan_theta;
+using math::onb::tan_theta_sq;
+using math::onb::cos_phi;
+using math::onb::sin_phi;
+using math::onb::cos_phi_sq;
+using math::onb::sin_phi_sq;
+using math::onb::same_hemisphere;
+} // namespace onb
+
+// swizzle.hpp
+using math::swizzle_indices;
+using math::component;
+using math::swizzle;
+using math::WW;
+using math::WWW;
+using math::WWWW;
+using math::WWWX;
+using math::WWWY;
+using math::WWWZ;
+using math::WWX;
+using math::WWXW;
+using math::WWXX;
+using math::WWXY;
+using math::WWXZ;
+using math::WWY;
+using math::WWYW;
+using math::WWYX;
+using math::WWYY;
+using math::WWYZ;
+using math::WWZ;
+using math::WWZW;
+using math::WWZX;
+using math::WWZY;
+using math::WWZZ;
+using math::WX;
+using math::WXW;
+using math::WXWW;
+using math::WXWX;
+using math::WXWY;
+using math::WXWZ;
+using math::WXX;
+using math::WXXW;
+using math::WXXX;
+using math::WXXY;
+using math::WXXZ;
+using math::WXY;
+using math::WXYW;
+using math::WXYX;
+using math::WXYY;
+using math::WXYZ;
+using math::WXZ;
+using math::WXZW;
+using math::WXZX;
+using math::WXZY;
+using math::WXZZ;
+using math::WY;
+using math::WYW;
+using math::WYWW;
+using math::WYWX;
+using math::WYWY;
+using math::WYWZ;
+using math::WYX;
+using math::WYXW;
+using math::WYXX;
+using math::WYXY;
+using math::WYXZ;
+using math::WYY;
+using math::WYYW;
+using math::WYYX;
+using math::WYYY;
+using math::WYYZ;
+using math::WYZ;
+using math::WYZW;
+using math::WYZX;
+using math::WYZY;
+using math::WYZZ;
+using math::WZ;
+using math::WZW;
+using math::WZWW;
+using math::WZWX;
+using math::WZWY;
+using math::WZWZ;
+using math::WZX;
+using math::WZXW;
+using math::WZXX;
+using math::WZXY;
+using math::WZXZ;
+using math::WZY;
+using math::WZYW;
+using math::WZYX;
+using math::WZYY;
+using math::WZYZ;
+using math::WZZ;
+using math::WZZW;
+using math::WZZX;
+using math::WZZY;
+using math::WZZZ;
+using math::XW;
+using math::XWW;
+using math::XWWW;
+using math::XWWX;
+using math::XWWY;
+using math::XWWZ;
+using math::XWX;
+using math::XWXW;
+using math::XWXX;
+using math::XWXY;
+using math::XWXZ;
+using math::XWY;
+using math::XWYW;
+using math::XWYX;
+using math::XWYY;
+using math::XWYZ;
+using math::XWZ;
+using math::XWZW;
+using math::XWZX;
+using math::XWZY;
+using math::XWZZ;
+using math::XX;
+using math::XXW;
+using math::XXWW;
+using math::XXWX;
+using math::XXWY;
+using math::XXWZ;
+using math::XXX;
+using math::XXXW;
+using math::XXXX;
+using math::XXXY;
+using math::XXXZ;
+using math::XXY;
+using math::XXYW;
+using math::XXYX;
+using math::XXYY;
+using math::XXYZ;
+using math::XXZ;
+using math::XXZW;
+using math::XXZX;
+using math::XXZY;
+using math::XXZZ;
+using math::XY;
+using math::XYW;
+using math::XYWW;
+using math::XYWX;
+using math::XYWY;
+using math::XYWZ;
+using math::XYX;
+using math::XYXW;
+using math::XYXX;
+using math::XYXY;
+using math::XYXZ;
+using math::XYY;
+using math::XYYW;
+using math::XYYX;
+using math::XYYY;
+using math::XYYZ;
+using math::XYZ;
+using math::XYZW;
+using math::XYZX;
+using math::XYZY;
+using math::XYZZ;
+using math::XZ;
+using math::XZW;
+using math::XZWW;
+using math::XZWX;
+using math::XZWY;
+using math::XZWZ;
+using math::XZX;
+using math::XZXW;
+using math::XZXX;
+using math::XZXY;
+using math::XZXZ;
+using math::XZY;
+using math::XZYW;
+using math::XZYX;
+using math::XZYY;
+using math::XZYZ;
+using math::XZZ;
+using math::XZZW;
+using math::XZZX;
+using math::XZZY;
+using math::XZZZ;
+using math::YW;
+using math::YWW;
+using math::YWWW;
+using math::YWWX;
+using math::YWWY;
+using math::YWWZ;
+using math::YWX;
+using math::YWXW;
+using math::YWXX;
+using math::YWXY;
+using math::YWXZ;
+using math::YWY;
+using math::YWYW;
+using math::YWYX;
+using math::YWYY;
+using math::YWYZ;
+using math::YWZ;
+using math::YWZW;
+using math::YWZX;
+using math::YWZY;
+using math::YWZZ;
+using math::YX;
+using math::YXW;
+using math::YXWW;
+using math::YXWX;
+using math::YXWY;
+using math::YXWZ;
+using math::YXX;
+using math::YXXW;
+using math::YXXX;
+using math::YXXY;
+using math::YXXZ;
+using math::YXY;
+using math::YXYW;
+using math::YXYX;
+using math::YXYY;
+using math::YXYZ;
+using math::YXZ;
+using math::YXZW;
+using math::YXZX;
+using math::YXZY;
+using math::YXZZ;
+using math::YY;
+using math::YYW;
+using math::YYWW;
+using math::YYWX;
+using math::YYWY;
+using math::YYWZ;
+using math::YYX;
+using math::YYXW;
+using math::YYXX;
+using math::YYXY;
+using math::YYXZ;
+using math::YYY;
+using math::YYYW;
+using math::YYYX;
+using math::YYYY;
+using math::YYYZ;
+using math::YYZ;
+using math::YYZW;
+using math::YYZX;
+using math::YYZY;
+using math::YYZZ;
+using math::YZ;
+using math::YZW;
+using math::YZWW;
+using math::YZWX;
+using math::YZWY;
+using math::YZWZ;
+using math::YZX;
+using math::YZXW;
+using math::YZXX;
+using math::YZXY;
+using math::YZXZ;
+using math::YZY;
+using math::YZYW;
+using math::YZYX;
+using math::YZYY;
+using math::YZYZ;
+using math::YZZ;
+using math::YZZW;
+using math::YZZX;
+using math::YZZY;
+using math::YZZZ;
+using math::ZW;
+using math::ZWW;
+using math::ZWWW;
+using math::ZWWX;
+using math::ZWWY;
+using math::ZWWZ;
+using math::ZWX;
+using math::ZWXW;
+using math::ZWXX;
+using math::ZWXY;
+using math::ZWXZ;
+using math::ZWY;
+using math::ZWYW;
+using math::ZWYX;
+using math::ZWYY;
+using math::ZWYZ;
+using math::ZWZ;
+using math::ZWZW;
+using math::ZWZX;
+using math::ZWZY;
+using math::ZWZZ;
+using math::ZX;
+using math::ZXW;
+using math::ZXWW;
+using math::ZXWX;
+using math::ZXWY;
+using math::ZXWZ;
+using math::ZXX;
+using math::ZXXW;
+using math::ZXXX;
+using math::ZXXY;
+using math::ZXXZ;
+using math::ZXY;
+using math::ZXYW;
+using math::ZXYX;
+using math::ZXYY;
+using math::ZXYZ;
+using math::ZXZ;
+using math::ZXZW;
+using math::ZXZX;
+using math::ZXZY;
+using math::ZXZZ;
+using math::ZY;
+using math::ZYW;
+using math::ZYWW;
+using math::ZYWX;
+using math::ZYWY;
+using math::ZYWZ;
+using math::ZYX;
+using math::ZYXW;
+using math::ZYXX;
+using math::ZYXY;
+using math::ZYXZ;
+using math::ZYY;
+using math::ZYYW;
+using math::ZYYX;
+using math::ZYYY;
+using math::ZYYZ;
+using math::ZYZ;
+using math::ZYZW;
+using math::ZYZX;
+using math::ZYZY;
+using math::ZYZZ;
+using math::ZZ;
+using math::ZZW;
+using math::ZZWW;
+using math::ZZWX;
+using math::ZZWY;
+using math::ZZWZ;
+using math::ZZX;
+using math::ZZXW;
+using math::ZZXX;
+using math::ZZXY;
+using math::ZZXZ;
+using math::ZZY;
+using math::ZZYW;
+using math::ZZYX;
+using math::ZZYY;
+using math::ZZYZ;
+using math::ZZZ;
+using math::ZZZW;
+using math::ZZZX;
+using math::ZZZY;
+using math::ZZZZ;
+
+// expression.hpp
+using math::lazy_operand;
+using math::lazy_scalar;
+using math::lazy_binary;
+using math::lazy_negate;
+using math::lazy;
+using math::lazy_as;
+using math::lazy_side;
+using math::lazy_pair;
+using math::lazy_node;
+using math::evaluate;
+
+// dynvector.hpp
+using math::dynvector;
+using math::pmr_dynvector;
+
+} // namespace math
+
+// dekker.hpp, the literal lives outside of math
+export using ::operator""_dk;
@@ -20,13 +20,28 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include "simd.hpp"
+#include "fast.hpp"
+#include "thread_pool.hpp"
 #include "vector.hpp"
+#include "vector_soa.hpp"
 #include "matrix.hpp"
+#include "transform.hpp"
+#include "parallel.hpp"
 #include "quaternion.hpp"
 #include "affine.hpp"
+#include "hierarchy.hpp"
+#include "dual_quaternion.hpp"
 #include "bounds.hpp"
 #include "dekker.hpp"
+#include "summation.hpp"
 #include "ray.hpp"
 #include "triangle.hpp"
+#include "bvh.hpp"
+#include "intersect.hpp"
+#include "ray_packet.hpp"
+#include "frustum.hpp"
 #include "utils.hpp"
-#include "swizzle.hpp"
\ No newline at end of file
+#include "swizzle.hpp"
+#include "expression.hpp"
+#include "dynvector.hpp"
\ No newline at end of file
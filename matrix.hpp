@@ -28,9 +28,11 @@
 
 #include "vector.hpp"
 #include "swizzle.hpp"
+#include "fast.hpp"
 #include <array>
 #include <algorithm>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 namespace math {
@@ -174,15 +176,72 @@ constexpr auto mul(const vector<T, R>& v, const matrix<T, R, C>& m)
     return result;
 }
 
-template<typename T, size_t R, size_t C>
-constexpr auto mul(const matrix<T, R, C>& a, const matrix<T, R, C>& b)
+// products up to 4x4 are register blocked, the columns of a are loaded once
+// and every result column is a chain of multiply-adds with broadcast
+// elements of b
+inline constexpr size_t matrix_block = 4;
+
+// larger products walk b in square tiles so a panel of a columns stays in
+// cache while it is reused across a tile of result columns
+inline constexpr size_t matrix_tile = 32;
+
+template<typename T, size_t R, size_t K, size_t C>
+constexpr auto mul_blocked(const matrix<T, R, K>& a, const matrix<T, K, C>& b)
+{
+    matrix<T, R, C> result(T(0));
+#if defined(LUCMATH_SIMD)
+    if constexpr (simd_loadable<T, R>) {
+        if (!std::is_constant_evaluated()) {
+            using lane = simd::pack<T, 4>;
+            std::array<lane, K> e;
+            for (size_t k = 0; k < K; k++)
+                e[k] = simd_load(a.columns[k]);
+            for (size_t j = 0; j < C; j++) {
+                auto c = e[0] * lane(b.values[j * K]);
+                for (size_t k = 1; k < K; k++)
+                    c = simd::fmadd(e[k], lane(b.values[j * K + k]), c);
+                result.columns[j] = simd_store<R>(c);
+            }
+            return result;
+        }
+    }
+#endif
+    for (size_t j = 0; j < C; j++) {
+        auto c = a.columns[0] * b.values[j * K];
+        for (size_t k = 1; k < K; k++)
+            c += a.columns[k] * b.values[j * K + k];
+        result.columns[j] = c;
+    }
+    return result;
+}
+
+template<typename T, size_t R, size_t K, size_t C>
+constexpr auto mul_tiled(const matrix<T, R, K>& a, const matrix<T, K, C>& b)
 {
-    const matrix<T, R, C> result([&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::array<vector<T, C>, R>{ mul(std::get<I>(b.columns), a)... };
-    }(std::make_index_sequence<R>{}));
+    matrix<T, R, C> result(T(0));
+    for (size_t j0 = 0; j0 < C; j0 += matrix_tile)
+        for (size_t k0 = 0; k0 < K; k0 += matrix_tile) {
+            const auto j1 = std::min(j0 + matrix_tile, C), k1 = std::min(k0 + matrix_tile, K);
+            for (size_t j = j0; j < j1; j++)
+                for (size_t k = k0; k < k1; k++) {
+                    const auto s = b.values[j * K + k];
+                    for (size_t i = 0; i < R; i++)
+                        result.values[j * R + i] += a.values[k * R + i] * s;
+                }
+        }
     return result;
 }
 
+// column major product, an R x K matrix times a K x C one
+template<typename T, size_t R, size_t K, size_t C>
+constexpr auto mul(const matrix<T, R, K>& a, const matrix<T, K, C>& b)
+{
+    if constexpr (R <= matrix_block && K <= matrix_block && C <= matrix_block)
+        return mul_blocked(a, b);
+    else
+        return mul_tiled(a, b);
+}
+
 template<typename T, size_t R, size_t C, size_t N>
 constexpr auto scale(const vector<T, N>& v)
 {
@@ -300,6 +359,89 @@ constexpr auto inverse(const matrix<T, N, N>& a)
     return result;
 }
 
+// closed-form inverses for the common transform classes, a 4x4 is a 3d
+// transform with the translation in w and a 3x3 a 2d one with it in z,
+// the bottom row is assumed to be 0 .. 0 1 and never read
+
+// any orthonormal matrix, rotations and reflections without translation
+template<typename T, size_t N>
+constexpr auto inverse_orthonormal(const matrix<T, N, N>& m)
+{
+    const auto result = transpose(m);
+    return result;
+}
+
+// the nearest rotation by gram-schmidt on the columns, x keeps its
+// direction, y is made orthogonal to it and z is their cross. Takes scale
+// and shear out of an orientation, a reflection loses its z column
+template<typename T>
+constexpr auto orthonormalize(const matrix<T, 3, 3>& m)
+{
+    const auto x = normalize(m.x);
+    const auto y = normalize(m.y - x * dot(x, m.y));
+    const matrix<T, 3, 3> result(x, y, cross(x, y));
+    return result;
+}
+
+// rotation and translation, the rotation is transposed and the
+// translation rotated back
+template<typename T>
+constexpr auto inverse_rigid(const matrix<T, 4, 4>& a)
+{
+    const matrix<T, 4, 4> result(
+      { a.x.x, a.y.x, a.z.x, T(0) },
+      { a.x.y, a.y.y, a.z.y, T(0) },
+      { a.x.z, a.y.z, a.z.z, T(0) },
+      { -(a.x.x * a.w.x + a.x.y * a.w.y + a.x.z * a.w.z),
+        -(a.y.x * a.w.x + a.y.y * a.w.y + a.y.z * a.w.z),
+        -(a.z.x * a.w.x + a.z.y * a.w.y + a.z.z * a.w.z),
+        T(1) });
+    return result;
+}
+
+template<typename T>
+constexpr auto inverse_rigid(const matrix<T, 3, 3>& a)
+{
+    const matrix<T, 3, 3> result(
+      { a.x.x, a.y.x, T(0) },
+      { a.x.y, a.y.y, T(0) },
+      { -(a.x.x * a.z.x + a.x.y * a.z.y), -(a.y.x * a.z.x + a.y.y * a.z.y), T(1) });
+    return result;
+}
+
+// any invertible linear part plus translation, the linear part goes through
+// its 3x3 adjugate and the translation is mapped back through the result
+template<typename T>
+constexpr auto inverse_affine(const matrix<T, 4, 4>& a)
+{
+    const matrix<T, 3, 3> linear({ a.x.x, a.x.y, a.x.z }, { a.y.x, a.y.y, a.y.z }, { a.z.x, a.z.y, a.z.z });
+    const auto adj = adjugate(linear);
+    const auto inv_det = T(1) / (a.x.x * adj.x.x + a.y.x * adj.x.y + a.z.x * adj.x.z);
+    const auto m = [&](size_t c, size_t r) { return adj.columns[c][r] * inv_det; };
+    const matrix<T, 4, 4> result(
+      { m(0, 0), m(0, 1), m(0, 2), T(0) },
+      { m(1, 0), m(1, 1), m(1, 2), T(0) },
+      { m(2, 0), m(2, 1), m(2, 2), T(0) },
+      { -(m(0, 0) * a.w.x + m(1, 0) * a.w.y + m(2, 0) * a.w.z),
+        -(m(0, 1) * a.w.x + m(1, 1) * a.w.y + m(2, 1) * a.w.z),
+        -(m(0, 2) * a.w.x + m(1, 2) * a.w.y + m(2, 2) * a.w.z),
+        T(1) });
+    return result;
+}
+
+template<typename T>
+constexpr auto inverse_affine(const matrix<T, 3, 3>& a)
+{
+    const auto inv_det = T(1) / (a.x.x * a.y.y - a.x.y * a.y.x);
+    const auto xx = a.y.y * inv_det, xy = -a.x.y * inv_det;
+    const auto yx = -a.y.x * inv_det, yy = a.x.x * inv_det;
+    const matrix<T, 3, 3> result(
+      { xx, xy, T(0) },
+      { yx, yy, T(0) },
+      { -(xx * a.z.x + yx * a.z.y), -(xy * a.z.x + yy * a.z.y), T(1) });
+    return result;
+}
+
 template<typename T>
 constexpr auto look_at(const vector<T, 3>& eye, const vector<T, 3>& target, const vector<T, 3>& up)
 {
@@ -343,6 +485,7 @@ constexpr auto perspective(const T& fovY, const T& aspect, const T& near, const
     result.values[10] = -(far + near) / fn;
     result.values[11] = T(-1);
     result.values[14] = -(far * near * T(2)) / fn;
+    result.values[15] = T(0);
     return result;
 }
 
@@ -371,12 +514,11 @@ constexpr auto orthographic(const T& left, const T& right, const T& bottom, cons
     return result;
 }
 
-template<typename T>
-constexpr auto rotation(const vector<T, 3>& axis, const T& angle)
+template<typename T, typename P = precise_policy>
+constexpr auto rotation(const vector<T, 3>& axis, const T& angle, P = {})
 {
     const auto na = normalize(axis);
-    const auto s = std::sin(angle);
-    const auto c = std::cos(angle);
+    const auto [s, c] = P::sincos(angle);
     const auto t = T(1) - c;
     const matrix<T, 4, 4> result({ na.x * na.x * t + c,
                                    na.y * na.x * t + na.z * s,
@@ -0,0 +1,137 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PARALLEL_MATH_H
+#define PARALLEL_MATH_H
+
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "affine.hpp"
+#include "quaternion.hpp"
+#include "bounds.hpp"
+#include "transform.hpp"
+#include "thread_pool.hpp"
+#include <span>
+
+namespace math {
+namespace parallel {
+
+// the span kernels of transform.hpp split over the global thread pool.
+// Every chunk writes at least parallel_bytes of output, short spans run in
+// place on the calling thread. Like the kernels they wrap they take spans
+// only, parallel::mul_many<float>(a, b, out)
+inline constexpr size_t parallel_bytes = size_t(1) << 14;
+
+template<typename T>
+inline constexpr size_t grain = (parallel_bytes / sizeof(T) + cache_line_items<T> - 1) / cache_line_items<T> * cache_line_items<T>;
+
+template<typename T, size_t N>
+auto bounds_of(span_in<T, N> points)
+{
+    const auto result = parallel_reduce(
+      points.size(), grain<vector<T, N>>, math::bounds<T, N>(),
+      [&](size_t first, size_t last) {
+          math::bounds<T, N> b;
+          for (size_t i = first; i < last; i++)
+              b.extend(points[i]);
+          return b;
+      },
+      [](math::bounds<T, N> a, const math::bounds<T, N>& b) { return a.extend(b); });
+    return result;
+}
+
+template<typename T>
+auto transform_points(const matrix<T, 4, 4>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    parallel_for(std::min(in.size(), out.size()), grain<vector<T, 3>>, [&](size_t first, size_t last) {
+        math::transform_points(m, in.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto transform_points(const affine<T>& a, span_in<T, 3> in, span_out<T, 3> out)
+{
+    parallel_for(std::min(in.size(), out.size()), grain<vector<T, 3>>, [&](size_t first, size_t last) {
+        math::transform_points(a, in.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto mul_many(matrix_in<T, 4> a, matrix_in<T, 4> b, matrix_out<T, 4> out)
+{
+    parallel_for(std::min({ a.size(), b.size(), out.size() }), grain<matrix<T, 4, 4>>, [&](size_t first, size_t last) {
+        math::mul_many<T>(a.subspan(first, last - first), b.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto mul_many(affine_in<T> a, affine_in<T> b, affine_out<T> out)
+{
+    parallel_for(std::min({ a.size(), b.size(), out.size() }), grain<affine<T>>, [&](size_t first, size_t last) {
+        math::mul_many<T>(a.subspan(first, last - first), b.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto mul_many(quaternion_in<T> a, quaternion_in<T> b, quaternion_out<T> out)
+{
+    parallel_for(std::min({ a.size(), b.size(), out.size() }), grain<quaternion<T>>, [&](size_t first, size_t last) {
+        math::mul_many<T>(a.subspan(first, last - first), b.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto rotate_many(quaternion_in<T> q, span_in<T, 3> in, span_out<T, 3> out)
+{
+    parallel_for(std::min({ q.size(), in.size(), out.size() }), grain<vector<T, 3>>, [&](size_t first, size_t last) {
+        math::rotate_many<T>(q.subspan(first, last - first), in.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto rotate_many(const quaternion<T>& q, span_in<T, 3> in, span_out<T, 3> out)
+{
+    parallel_for(std::min(in.size(), out.size()), grain<vector<T, 3>>, [&](size_t first, size_t last) {
+        math::rotate_many<T>(q, in.subspan(first, last - first), out.subspan(first, last - first));
+    });
+}
+
+template<typename T>
+auto from_euler_many(span_in<T, 3> in, quaternion_out<T> out, euler_order order = euler_order::xyz)
+{
+    parallel_for(std::min(in.size(), out.size()), grain<quaternion<T>>, [&](size_t first, size_t last) {
+        math::from_euler_many<T>(in.subspan(first, last - first), out.subspan(first, last - first), order);
+    });
+}
+
+template<typename T>
+auto to_euler_many(quaternion_in<T> in, span_out<T, 3> out, euler_order order = euler_order::xyz)
+{
+    parallel_for(std::min(in.size(), out.size()), grain<vector<T, 3>>, [&](size_t first, size_t last) {
+        math::to_euler_many<T>(in.subspan(first, last - first), out.subspan(first, last - first), order);
+    });
+}
+
+} // namespace parallel
+} // namespace math
+
+#endif /* PARALLEL_MATH_H */
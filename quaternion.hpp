@@ -25,8 +25,10 @@
 
 #include "vector.hpp"
 #include "matrix.hpp"
+#include "fast.hpp"
 #include <array>
 #include <numeric>
+#include <utility>
 
 namespace math {
 template<typename T>
@@ -245,6 +247,41 @@ constexpr auto rotation3(const quaternion<T>& q)
 //     return m;
 // }
 
+// the inverse of a unit quaternion
+template<typename T>
+constexpr auto conjugate(const quaternion<T>& q)
+{
+    const quaternion<T> result(-q.x, -q.y, -q.z, q.w);
+    return result;
+}
+
+// the unit quaternion of a rotation matrix, the inverse of rotation3. The
+// largest of w, x, y and z is taken from the diagonal first so the divisor
+// never gets close to zero
+template<typename T>
+constexpr auto from_rotation(const matrix<T, 3, 3>& m)
+{
+    const auto trace = m.x.x + m.y.y + m.z.z;
+    if (trace > T(0)) {
+        const auto s = std::sqrt(trace + T(1)) * T(2);
+        const quaternion<T> result((m.y.z - m.z.y) / s, (m.z.x - m.x.z) / s, (m.x.y - m.y.x) / s, s * T(.25));
+        return result;
+    }
+    if (m.x.x > m.y.y && m.x.x > m.z.z) {
+        const auto s = std::sqrt(T(1) + m.x.x - m.y.y - m.z.z) * T(2);
+        const quaternion<T> result(s * T(.25), (m.y.x + m.x.y) / s, (m.z.x + m.x.z) / s, (m.y.z - m.z.y) / s);
+        return result;
+    }
+    if (m.y.y > m.z.z) {
+        const auto s = std::sqrt(T(1) + m.y.y - m.x.x - m.z.z) * T(2);
+        const quaternion<T> result((m.y.x + m.x.y) / s, s * T(.25), (m.z.y + m.y.z) / s, (m.z.x - m.x.z) / s);
+        return result;
+    }
+    const auto s = std::sqrt(T(1) + m.z.z - m.x.x - m.y.y) * T(2);
+    const quaternion<T> result((m.z.x + m.x.z) / s, (m.z.y + m.y.z) / s, s * T(.25), (m.x.y - m.y.x) / s);
+    return result;
+}
+
 template<typename T>
 constexpr auto inverse(const quaternion<T>& q)
 {
@@ -272,8 +309,8 @@ auto lerp_normalized(const T& x, const quaternion<T>& a, const quaternion<T>& b)
     return result;
 }
 
-template<typename T>
-auto slerp(const T& x, const quaternion<T>& a, const quaternion<T>& b)
+template<typename T, typename P = precise_policy>
+auto slerp(const T& x, const quaternion<T>& a, const quaternion<T>& b, P = {})
 {
     quaternion<T> result;
     const auto cos_half_theta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
@@ -288,15 +325,15 @@ auto slerp(const T& x, const quaternion<T>& a, const quaternion<T>& b)
         return result;
     }
     else {
-        const auto half_theta = std::acos(cos_half_theta1);
+        const auto half_theta = P::acos(cos_half_theta1);
         const auto sin_half_theta = std::sqrt(T(1) - cos_half_theta1 * cos_half_theta1);
         if (std::abs(sin_half_theta) < std::numeric_limits<T>::epsilon()) {
             const auto result = a * T(.5) + b1 * T(.5);
             return result;
         }
         else {
-            const auto A = std::sin((T(1) - x) * half_theta) / sin_half_theta;
-            const auto B = std::sin(x * half_theta) / sin_half_theta;
+            const auto A = P::sin((T(1) - x) * half_theta) / sin_half_theta;
+            const auto B = P::sin(x * half_theta) / sin_half_theta;
             const auto result = a * A + b1 * B;
             return result;
         }
@@ -305,43 +342,75 @@ auto slerp(const T& x, const quaternion<T>& a, const quaternion<T>& b)
     return result;
 }
 
+// the order the three axis rotations of an euler triple apply in, xyz turns
+// about x first and z last, q = qz qy qx. Whatever the order the angle
+// about each axis stays in its own component of the triple
+enum class euler_order {
+    xyz,
+    xzy,
+    yxz,
+    yzx,
+    zxy,
+    zyx
+};
+
+// the axes in the order they apply, and 1 when that order is a cyclic shift
+// of xyz or -1 when two axes trade places, the sign of every cross term
 template<typename T>
-constexpr auto from_euler(const vector<T, 3>& e)
+constexpr auto euler_axes(euler_order order)
 {
-    const auto x0 = std::cos(e.x * T(.5));
-    const auto x1 = std::sin(e.x * T(.5));
-    const auto y0 = std::cos(e.y * T(.5));
-    const auto y1 = std::sin(e.y * T(.5));
-    const auto z0 = std::cos(e.z * T(.5));
-    const auto z1 = std::sin(e.z * T(.5));
-    const math::quaternion<T> result(
-      x1 * y0 * z0 - x0 * y1 * z1,
-      x0 * y1 * z0 + x1 * y0 * z1,
-      x0 * y0 * z1 - x1 * y1 * z0,
-      x0 * y0 * z0 + x1 * y1 * z1);
+    constexpr std::array<std::array<size_t, 3>, 6> axes{
+        { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } }
+    };
+    const auto a = axes[size_t(order)];
+    const auto parity = a[1] == (a[0] + 1) % 3 ? T(1) : T(-1);
+    return std::make_pair(a, parity);
+}
+
+// q = qk qj qi for the axes i, j, k in the order they apply
+template<typename T, typename P = precise_policy>
+constexpr auto from_euler(const vector<T, 3>& e, euler_order order = euler_order::xyz, P = {})
+{
+    const auto [axes, parity] = euler_axes<T>(order);
+    const auto [i, j, k] = axes;
+    const auto [si, ci] = P::sincos(e[i] * T(.5));
+    const auto [sj, cj] = P::sincos(e[j] * T(.5));
+    const auto [sk, ck] = P::sincos(e[k] * T(.5));
+    vector<T, 3> v;
+    v[i] = si * cj * ck - parity * ci * sj * sk;
+    v[j] = ci * sj * ck + parity * si * cj * sk;
+    v[k] = ci * cj * sk - parity * si * sj * ck;
+    const quaternion<T> result(v, ci * cj * ck + parity * si * sj * sk);
     return result;
 }
 
-template<typename T>
-constexpr auto from_euler(const T& pitch, const T& roll, const T& yaw)
+template<typename T, typename P = precise_policy>
+constexpr auto from_euler(const T& pitch, const T& roll, const T& yaw, euler_order order = euler_order::xyz, P = {})
 {
-    return from_euler(vector<T, 3>(pitch, roll, yaw));
+    return from_euler(vector<T, 3>(pitch, roll, yaw), order, P{});
 }
 
-template<typename T>
-constexpr auto to_euler(const quaternion<T>& q)
+// the middle axis goes through asin and is clamped to [-pi/2, pi/2], the
+// outer two through atan2
+template<typename T, typename P = precise_policy>
+constexpr auto to_euler(const quaternion<T>& q, euler_order order = euler_order::xyz, P = {})
 {
-    const auto x0 = T(2) * (q.w * q.x + q.y * q.z);
-    const auto x1 = T(1) - T(2) * (q.x * q.x + q.y * q.y);
-    const auto y0 = T(2) * (q.w * q.y - q.z * q.x);
-    const auto y1 = y0 > T(1) ? T(1) : y0;
-    const auto y2 = y1 < -T(1) ? -T(1) : y1;
-    const auto z0 = T(2) * (q.w * q.z + q.x * q.y);
-    const auto z1 = T(1) - T(2) * (q.y * q.y + q.z * q.z);
-    const auto x = std::atan2(x0, x1);
-    const auto y = std::asin(y2);
-    const auto z = std::atan2(z0, z1);
-    const vector<T, 3> result(x, y, z);
+    const auto [axes, parity] = euler_axes<T>(order);
+    const auto [i, j, k] = axes;
+    const auto qi = q.vec[i];
+    const auto qj = q.vec[j];
+    const auto qk = q.vec[k];
+    const auto i0 = T(2) * (q.w * qi + parity * qj * qk);
+    const auto i1 = T(1) - T(2) * (qi * qi + qj * qj);
+    const auto j0 = T(2) * (q.w * qj - parity * qi * qk);
+    const auto j1 = j0 > T(1) ? T(1) : j0;
+    const auto j2 = j1 < -T(1) ? -T(1) : j1;
+    const auto k0 = T(2) * (q.w * qk + parity * qi * qj);
+    const auto k1 = T(1) - T(2) * (qj * qj + qk * qk);
+    vector<T, 3> result;
+    result[i] = P::atan2(i0, i1);
+    result[j] = P::asin(j2);
+    result[k] = P::atan2(k0, k1);
     return result;
 }
 
@@ -0,0 +1,202 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RAY_PACKET_MATH_H
+#define RAY_PACKET_MATH_H
+
+#include "vector.hpp"
+#include "vector_soa.hpp"
+#include "simd.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+#include "triangle.hpp"
+#include "intersect.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace math {
+
+// W rays in SoA, lanes outside active are carried along but never report hits
+template<typename T, size_t W>
+struct ray_packet {
+    using lane = simd::pack<T, W>;
+    using mask = simd::mask<T, W>;
+
+    ray_packet() = default;
+
+    ray_packet(const vector_soa<T, 3, W>& p, const vector_soa<T, 3, W>& d, const lane& tmin, const lane& tmax, const mask& active) :
+      p(p), d(d), tmin(tmin), tmax(tmax), active(active)
+    {
+        inv_d = vector_soa<T, 3, W>(T(1)) / d;
+        // one shear axis for the whole packet, the one whose smallest active
+        // component is largest, coherent packets share their dominant axis.
+        // When every axis is zero for some active ray the triangle test
+        // shears ray by ray instead
+        T best = T(-1);
+        for (size_t k = 0; k < 3; k++) {
+            const auto a = simd::select(active, simd::abs(d[k]), lane(std::numeric_limits<T>::infinity()));
+            const auto smallest = simd::reduce_min(a);
+            if (smallest > best) {
+                best = smallest;
+                kz = k;
+            }
+        }
+        shared = best > T(0);
+        kx = (kz + 1) % 3;
+        ky = (kx + 1) % 3;
+        const auto sz = lane(T(1)) / d[kz];
+        shear = vector_soa<T, 3, W>({ d[kx] * sz, d[ky] * sz, sz });
+    }
+
+    // up to W rays, missing lanes are inactive
+    static auto load(std::span<const ray<T, 3>> rays, T tmin, T tmax)
+    {
+        const auto count = std::min(W, rays.size());
+        std::array<vector<T, 3>, W> p{}, d;
+        d.fill(vector<T, 3>(T(1)));
+        for (size_t i = 0; i < count; i++) {
+            p[i] = rays[i].p;
+            d[i] = rays[i].d;
+        }
+        const auto result = ray_packet(vector_soa<T, 3, W>::load(p), vector_soa<T, 3, W>::load(d), lane(tmin), lane(tmax),
+                                       lane_index() < lane(T(count)));
+        return result;
+    }
+
+    auto store(std::span<ray<T, 3>> rays) const
+    {
+        for (size_t i = 0; i < std::min(W, rays.size()); i++)
+            rays[i] = extract(i);
+    }
+
+    auto extract(size_t i) const
+    {
+        const ray<T, 3> result{ p.extract(i), d.extract(i) };
+        return result;
+    }
+
+    auto along(const lane& t) const
+    {
+        const auto result = p + d * t;
+        return result;
+    }
+
+    static auto lane_index()
+    {
+        std::array<T, W> result;
+        for (size_t i = 0; i < W; i++)
+            result[i] = T(i);
+        return lane(result);
+    }
+
+    vector_soa<T, 3, W> p, d, inv_d;
+    lane tmin, tmax;
+    mask active;
+    vector_soa<T, 3, W> shear;
+    size_t kx = 0, ky = 1, kz = 2;
+    bool shared = true;
+};
+
+// entry distance per ray clipped to [tmin, tmax], infinity where the ray
+// misses or is inactive. Returns right after x and y once every ray missed
+template<typename T, size_t W>
+auto intersect(const ray_packet<T, W>& rays, const bounds<T, 3>& b)
+{
+    using lane = simd::pack<T, W>;
+    const lane miss(std::numeric_limits<T>::infinity());
+    auto t_near = rays.tmin;
+    auto t_far = rays.tmax;
+    for (size_t a = 0; a < 3; a++) {
+        const auto t0 = (lane(b.min[a]) - rays.p[a]) * rays.inv_d[a];
+        const auto t1 = (lane(b.max[a]) - rays.p[a]) * rays.inv_d[a];
+        t_near = simd::max(t_near, simd::min(t0, t1));
+        t_far = simd::min(t_far, simd::max(t0, t1));
+        if (a == 1 && simd::none(rays.active & (t_near <= t_far)))
+            return miss;
+    }
+    const auto result = simd::select(rays.active & (t_near <= t_far), t_near, miss);
+    return result;
+}
+
+// the scalar watertight test ray by ray, for packets without a shared axis
+template<typename T, size_t W>
+auto intersect_each(const ray_packet<T, W>& rays, const triangle<T>& tri)
+{
+    using lane = simd::pack<T, W>;
+    std::array<T, W> t, u, v;
+    t.fill(std::numeric_limits<T>::infinity());
+    u.fill(T(0));
+    v.fill(T(0));
+    for (auto bits = simd::bitmask(rays.active); bits; bits &= bits - 1) {
+        const auto i = size_t(std::countr_zero(bits));
+        const auto h = intersect(watertight_ray<T>(rays.extract(i)), tri, rays.tmin[i], rays.tmax[i]);
+        if (h) {
+            t[i] = h->t;
+            u[i] = h->u;
+            v[i] = h->v;
+        }
+    }
+    const triangle_hit<lane> result{ lane(t), lane(u), lane(v) };
+    return result;
+}
+
+// watertight per ray, skips the depth and division once every ray is outside
+template<typename T, size_t W>
+auto intersect(const ray_packet<T, W>& rays, const triangle<T>& tri)
+{
+    using lane = simd::pack<T, W>;
+    const lane zero(T(0));
+    const lane miss(std::numeric_limits<T>::infinity());
+    if (!rays.shared)
+        return intersect_each(rays, tri);
+    const auto project = [&](const vector<T, 3>& v) {
+        const auto x = lane(v[rays.kx]) - rays.p[rays.kx];
+        const auto y = lane(v[rays.ky]) - rays.p[rays.ky];
+        const auto z = lane(v[rays.kz]) - rays.p[rays.kz];
+        return std::array<lane, 3>{ x - rays.shear[0] * z, y - rays.shear[1] * z, rays.shear[2] * z };
+    };
+    const auto a = project(tri[0]);
+    const auto b = project(tri[1]);
+    const auto c = project(tri[2]);
+    const auto u = difference_of_products(c[0], b[1], c[1], b[0]);
+    const auto v = difference_of_products(a[0], c[1], a[1], c[0]);
+    const auto w = difference_of_products(b[0], a[1], b[1], a[0]);
+    const auto inside = rays.active & (((u >= zero) & (v >= zero) & (w >= zero)) | ((u <= zero) & (v <= zero) & (w <= zero)));
+    if (simd::none(inside))
+        return triangle_hit<lane>{ miss, zero, zero };
+    const auto det = u + v + w;
+    const auto inv = lane(T(1)) / det;
+    const auto t = (u * a[2] + v * b[2] + w * c[2]) * inv;
+    const auto hit = inside & (simd::abs(det) > zero) & (t > rays.tmin) & (t < rays.tmax);
+    const triangle_hit<lane> result{ simd::select(hit, t, miss), v * inv, w * inv };
+    return result;
+}
+
+using rayf3_packet4 = ray_packet<float, 4>;
+using rayf3_packet8 = ray_packet<float, 8>;
+
+} // namespace math
+
+#endif /* RAY_PACKET_MATH_H */
@@ -0,0 +1,1748 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Opt-in register backend, enabled by defining LUCMATH_SIMD before including
+// any header. The instruction set is picked from the compiler target flags,
+// anything not covered falls back to plain loops over std::array.
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#if defined(LUCMATH_SIMD)
+#if defined(__AVX512F__)
+#define LUCMATH_SIMD_AVX512
+#endif
+#if defined(__AVX2__)
+#define LUCMATH_SIMD_AVX2
+#endif
+#if defined(__SSE4_1__)
+#define LUCMATH_SIMD_SSE41
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define LUCMATH_SIMD_NEON
+#endif
+#endif
+
+#if defined(LUCMATH_SIMD_SSE41) || defined(LUCMATH_SIMD_AVX2) || defined(LUCMATH_SIMD_AVX512)
+#include <immintrin.h>
+#endif
+#if defined(LUCMATH_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace math {
+namespace simd {
+
+// widest register the target offers, used to size packets and batch kernels
+#if defined(LUCMATH_SIMD_AVX512)
+template<typename T>
+inline constexpr size_t native_width = 64 / sizeof(T);
+#elif defined(LUCMATH_SIMD_AVX2)
+template<typename T>
+inline constexpr size_t native_width = 32 / sizeof(T);
+#else
+template<typename T>
+inline constexpr size_t native_width = 16 / sizeof(T);
+#endif
+
+template<typename T, size_t W>
+struct pack {
+    pack() = default;
+
+    constexpr pack(const T& t)
+    {
+        std::fill(std::begin(values), std::end(values), t);
+    }
+
+    constexpr pack(const std::array<T, W>& a) :
+      values(a) {}
+
+    static auto load(const T* p)
+    {
+        pack result;
+        std::copy(p, p + W, std::begin(result.values));
+        return result;
+    }
+
+    auto store(T* p) const
+    {
+        std::copy(std::begin(values), std::end(values), p);
+    }
+
+    static auto load3(const T* p)
+        requires(W == 4)
+    {
+        const pack result(std::array<T, 4>{ p[0], p[1], p[2], T(0) });
+        return result;
+    }
+
+    auto store3(T* p) const
+        requires(W == 4)
+    {
+        std::copy(std::begin(values), std::begin(values) + 3, p);
+    }
+
+    template<size_t... I>
+    auto shuffle() const
+    {
+        const pack<T, sizeof...(I)> result(std::array<T, sizeof...(I)>{ values[I]... });
+        return result;
+    }
+
+    // lane i comes from b where bit i of Mask is set
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        pack result;
+        for (size_t i = 0; i < W; i++)
+            result.values[i] = (Mask >> i) & 1 ? b.values[i] : values[i];
+        return result;
+    }
+
+    T operator[](std::size_t i) const
+    {
+        return values[i];
+    }
+
+    std::array<T, W> values{};
+};
+
+template<typename T, size_t W>
+struct mask {
+    std::array<bool, W> values{};
+};
+
+template<typename Op, typename T, size_t W>
+constexpr auto lanewise(const pack<T, W>& a, const pack<T, W>& b)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = Op{}(a.values[i], b.values[i]);
+    return result;
+}
+
+template<typename Op, typename T, size_t W>
+constexpr auto compare(const pack<T, W>& a, const pack<T, W>& b)
+{
+    mask<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = Op{}(a.values[i], b.values[i]);
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto operator+(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return lanewise<std::plus<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator-(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return lanewise<std::minus<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator*(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return lanewise<std::multiplies<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator/(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return lanewise<std::divides<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator-(const pack<T, W>& a)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = -a.values[i];
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto min(const pack<T, W>& a, const pack<T, W>& b)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = std::min(a.values[i], b.values[i]);
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto max(const pack<T, W>& a, const pack<T, W>& b)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = std::max(a.values[i], b.values[i]);
+    return result;
+}
+
+template<typename T, size_t W>
+auto abs(const pack<T, W>& a)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = std::abs(a.values[i]);
+    return result;
+}
+
+template<typename T, size_t W>
+auto sqrt(const pack<T, W>& a)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = std::sqrt(a.values[i]);
+    return result;
+}
+
+// 1 / sqrt(a), the register packs refine the hardware estimate with Newton
+// steps to within a few ulp instead of dividing
+template<typename T, size_t W>
+inline auto rsqrt(const pack<T, W>& a)
+{
+    const auto result = pack<T, W>(T(1)) / sqrt(a);
+    return result;
+}
+
+// a * 2^k for whole k that keep 2^k a normal number, the scale is written
+// into the exponent bits rather than calling std::ldexp per lane
+template<typename T, size_t W>
+inline auto ldexp(const pack<T, W>& a, const pack<T, W>& k)
+{
+    using bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    using whole = std::make_signed_t<bits>;
+    constexpr auto fraction = std::numeric_limits<T>::digits - 1;
+    constexpr auto bias = std::numeric_limits<T>::max_exponent - 1;
+    pack<T, W> scale;
+    for (size_t i = 0; i < W; i++)
+        scale.values[i] = std::bit_cast<T>(bits(whole(k.values[i]) + bias) << fraction);
+    const auto result = a * scale;
+    return result;
+}
+
+// m in [1, 2) and the whole e with x = m * 2^e, for positive normal x
+template<typename T, size_t W>
+inline auto split_exponent(const pack<T, W>& x)
+{
+    using bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    using whole = std::make_signed_t<bits>;
+    constexpr auto fraction = std::numeric_limits<T>::digits - 1;
+    constexpr auto bias = std::numeric_limits<T>::max_exponent - 1;
+    constexpr auto fraction_mask = (bits(1) << fraction) - 1;
+    pack<T, W> m, e;
+    for (size_t i = 0; i < W; i++) {
+        const auto b = std::bit_cast<bits>(x.values[i]);
+        m.values[i] = std::bit_cast<T>((b & fraction_mask) | std::bit_cast<bits>(T(1)));
+        e.values[i] = T(whole(b >> fraction) - bias);
+    }
+    return std::make_pair(m, e);
+}
+
+// whether std::fma of T is as fast as a multiply and an add on the target
+template<typename T>
+inline constexpr bool fast_fma = false;
+#if defined(FP_FAST_FMA)
+template<>
+inline constexpr bool fast_fma<double> = true;
+#endif
+#if defined(FP_FAST_FMAF)
+template<>
+inline constexpr bool fast_fma<float> = true;
+#endif
+
+// a * b + c, rounded once only where the target has fma (fast_fma of T here,
+// __FMA__ or NEON for the register overloads). Elsewhere the product rounds
+// first, the range reductions split their constants so the leading products
+// stay exact either way and only the documented error bounds move
+template<typename T, size_t W>
+constexpr auto fmadd(const pack<T, W>& a, const pack<T, W>& b, const pack<T, W>& c)
+{
+    if constexpr (fast_fma<T>) {
+        if (!std::is_constant_evaluated()) {
+            pack<T, W> result;
+            for (size_t i = 0; i < W; i++)
+                result.values[i] = std::fma(a.values[i], b.values[i], c.values[i]);
+            return result;
+        }
+    }
+    const auto result = a * b + c;
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto operator<(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return compare<std::less<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator<=(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return compare<std::less_equal<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator>(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return compare<std::greater<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator>=(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return compare<std::greater_equal<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator==(const pack<T, W>& a, const pack<T, W>& b)
+{
+    return compare<std::equal_to<void>>(a, b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator&(const mask<T, W>& a, const mask<T, W>& b)
+{
+    mask<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = a.values[i] && b.values[i];
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto operator|(const mask<T, W>& a, const mask<T, W>& b)
+{
+    mask<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = a.values[i] || b.values[i];
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto bitmask(const mask<T, W>& m)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < W; i++)
+        result |= uint32_t(m.values[i]) << i;
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto select(const mask<T, W>& m, const pack<T, W>& a, const pack<T, W>& b)
+{
+    pack<T, W> result;
+    for (size_t i = 0; i < W; i++)
+        result.values[i] = m.values[i] ? a.values[i] : b.values[i];
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto reduce_add(const pack<T, W>& a)
+{
+    T result = a.values[0];
+    for (size_t i = 1; i < W; i++)
+        result += a.values[i];
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto reduce_min(const pack<T, W>& a)
+{
+    T result = a.values[0];
+    for (size_t i = 1; i < W; i++)
+        result = std::min(result, a.values[i]);
+    return result;
+}
+
+template<typename T, size_t W>
+constexpr auto reduce_max(const pack<T, W>& a)
+{
+    T result = a.values[0];
+    for (size_t i = 1; i < W; i++)
+        result = std::max(result, a.values[i]);
+    return result;
+}
+
+// the lanes of a followed by b split by parity, even lanes first
+template<typename T, size_t W>
+constexpr auto unzip(const pack<T, W>& a, const pack<T, W>& b)
+{
+    std::array<pack<T, W>, 2> result;
+    for (size_t i = 0; i < W; i++)
+        for (size_t k = 0; k < 2; k++) {
+            const auto j = 2 * i + k;
+            result[k].values[i] = j < W ? a.values[j] : b.values[j - W];
+        }
+    return result;
+}
+
+// the inverse of unzip, lanes of a and b alternate across both results
+template<typename T, size_t W>
+constexpr auto zip(const pack<T, W>& a, const pack<T, W>& b)
+{
+    std::array<pack<T, W>, 2> result;
+    for (size_t i = 0; i < W; i++) {
+        result[(2 * i) / W].values[(2 * i) % W] = a.values[i];
+        result[(2 * i + 1) / W].values[(2 * i + 1) % W] = b.values[i];
+    }
+    return result;
+}
+
+#if defined(LUCMATH_SIMD_SSE41)
+template<>
+struct pack<float, 4> {
+    pack() = default;
+
+    pack(const float& t) :
+      v(_mm_set1_ps(t)) {}
+
+    pack(const std::array<float, 4>& a) :
+      v(_mm_loadu_ps(a.data())) {}
+
+    pack(const __m128& r) :
+      v(r) {}
+
+    static auto load(const float* p)
+    {
+        const pack result(_mm_loadu_ps(p));
+        return result;
+    }
+
+    auto store(float* p) const
+    {
+        _mm_storeu_ps(p, v);
+    }
+
+    // __m64 may alias anything, going through double* would break strict aliasing
+    static auto load3(const float* p)
+    {
+        const auto xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+        const pack result(_mm_movelh_ps(xy, _mm_load_ss(p + 2)));
+        return result;
+    }
+
+    auto store3(float* p) const
+    {
+        _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+
+    template<size_t I0, size_t I1, size_t I2, size_t I3>
+    auto shuffle() const
+    {
+        const pack result(_mm_shuffle_ps(v, v, _MM_SHUFFLE(I3, I2, I1, I0)));
+        return result;
+    }
+
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        const pack result(_mm_blend_ps(v, b.v, Mask));
+        return result;
+    }
+
+    float operator[](std::size_t i) const
+    {
+        alignas(16) float t[4];
+        _mm_store_ps(t, v);
+        return t[i];
+    }
+
+    __m128 v;
+};
+
+template<>
+struct mask<float, 4> {
+    __m128 v;
+};
+
+inline auto operator+(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_add_ps(a.v, b.v)); }
+inline auto operator-(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_sub_ps(a.v, b.v)); }
+inline auto operator*(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_mul_ps(a.v, b.v)); }
+inline auto operator/(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_div_ps(a.v, b.v)); }
+inline auto operator-(const pack<float, 4>& a) { return pack<float, 4>(_mm_xor_ps(a.v, _mm_set1_ps(-0.f))); }
+// argument order keeps std::min/std::max semantics: b is returned only when it strictly wins
+inline auto min(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_min_ps(b.v, a.v)); }
+inline auto max(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_max_ps(b.v, a.v)); }
+inline auto abs(const pack<float, 4>& a) { return pack<float, 4>(_mm_andnot_ps(_mm_set1_ps(-0.f), a.v)); }
+inline auto sqrt(const pack<float, 4>& a) { return pack<float, 4>(_mm_sqrt_ps(a.v)); }
+inline auto operator<(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ _mm_cmplt_ps(a.v, b.v) }; }
+inline auto operator<=(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ _mm_cmple_ps(a.v, b.v) }; }
+inline auto operator>(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ _mm_cmpgt_ps(a.v, b.v) }; }
+inline auto operator>=(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ _mm_cmpge_ps(a.v, b.v) }; }
+inline auto operator==(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ _mm_cmpeq_ps(a.v, b.v) }; }
+inline auto operator&(const mask<float, 4>& a, const mask<float, 4>& b) { return mask<float, 4>{ _mm_and_ps(a.v, b.v) }; }
+inline auto operator|(const mask<float, 4>& a, const mask<float, 4>& b) { return mask<float, 4>{ _mm_or_ps(a.v, b.v) }; }
+inline auto bitmask(const mask<float, 4>& m) { return uint32_t(_mm_movemask_ps(m.v)); }
+inline auto select(const mask<float, 4>& m, const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(_mm_blendv_ps(b.v, a.v, m.v)); }
+
+// two roundings without __FMA__, like the generic fmadd
+inline auto fmadd(const pack<float, 4>& a, const pack<float, 4>& b, const pack<float, 4>& c)
+{
+#if defined(__FMA__)
+    return pack<float, 4>(_mm_fmadd_ps(a.v, b.v, c.v));
+#else
+    return a * b + c;
+#endif
+}
+
+inline auto reduce_add(const pack<float, 4>& a)
+{
+    const auto hi = _mm_movehl_ps(a.v, a.v);
+    const auto s2 = _mm_add_ps(a.v, hi);
+    const auto s1 = _mm_add_ss(s2, _mm_shuffle_ps(s2, s2, _MM_SHUFFLE(1, 1, 1, 1)));
+    const auto result = _mm_cvtss_f32(s1);
+    return result;
+}
+
+inline auto reduce_min(const pack<float, 4>& a)
+{
+    const auto s2 = _mm_min_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    const auto s1 = _mm_min_ss(s2, _mm_shuffle_ps(s2, s2, _MM_SHUFFLE(1, 1, 1, 1)));
+    const auto result = _mm_cvtss_f32(s1);
+    return result;
+}
+
+inline auto reduce_max(const pack<float, 4>& a)
+{
+    const auto s2 = _mm_max_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    const auto s1 = _mm_max_ss(s2, _mm_shuffle_ps(s2, s2, _MM_SHUFFLE(1, 1, 1, 1)));
+    const auto result = _mm_cvtss_f32(s1);
+    return result;
+}
+
+inline auto unzip(const pack<float, 4>& a, const pack<float, 4>& b)
+{
+    const std::array<pack<float, 4>, 2> result{ pack<float, 4>(_mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0))),
+                                                pack<float, 4>(_mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1))) };
+    return result;
+}
+
+inline auto zip(const pack<float, 4>& a, const pack<float, 4>& b)
+{
+    const std::array<pack<float, 4>, 2> result{ pack<float, 4>(_mm_unpacklo_ps(a.v, b.v)), pack<float, 4>(_mm_unpackhi_ps(a.v, b.v)) };
+    return result;
+}
+
+// rsqrtps is good to 12 bits, one Newton step takes it to float precision
+inline auto rsqrt(const pack<float, 4>& a)
+{
+    const pack<float, 4> y(_mm_rsqrt_ps(a.v));
+    const auto result = y * (pack<float, 4>(1.5f) - pack<float, 4>(.5f) * a * y * y);
+    return result;
+}
+
+inline auto ldexp(const pack<float, 4>& a, const pack<float, 4>& k)
+{
+    const auto scale = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(k.v), _mm_set1_epi32(127)), 23);
+    const auto result = a * pack<float, 4>(_mm_castsi128_ps(scale));
+    return result;
+}
+
+inline auto split_exponent(const pack<float, 4>& x)
+{
+    const auto b = _mm_castps_si128(x.v);
+    const auto m = _mm_or_si128(_mm_and_si128(b, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000));
+    const auto e = _mm_sub_epi32(_mm_srli_epi32(b, 23), _mm_set1_epi32(127));
+    return std::make_pair(pack<float, 4>(_mm_castsi128_ps(m)), pack<float, 4>(_mm_cvtepi32_ps(e)));
+}
+#elif defined(LUCMATH_SIMD_NEON)
+template<>
+struct pack<float, 4> {
+    pack() = default;
+
+    pack(const float& t) :
+      v(vdupq_n_f32(t)) {}
+
+    pack(const std::array<float, 4>& a) :
+      v(vld1q_f32(a.data())) {}
+
+    pack(const float32x4_t& r) :
+      v(r) {}
+
+    static auto load(const float* p)
+    {
+        const pack result(vld1q_f32(p));
+        return result;
+    }
+
+    auto store(float* p) const
+    {
+        vst1q_f32(p, v);
+    }
+
+    static auto load3(const float* p)
+    {
+        const pack result(vcombine_f32(vld1_f32(p), vld1_lane_f32(p + 2, vdup_n_f32(0.f), 0)));
+        return result;
+    }
+
+    auto store3(float* p) const
+    {
+        vst1_f32(p, vget_low_f32(v));
+        vst1q_lane_f32(p + 2, v, 2);
+    }
+
+    template<size_t I0, size_t I1, size_t I2, size_t I3>
+    auto shuffle() const
+    {
+        const pack result(float32x4_t{ vgetq_lane_f32(v, I0), vgetq_lane_f32(v, I1), vgetq_lane_f32(v, I2), vgetq_lane_f32(v, I3) });
+        return result;
+    }
+
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        const uint32x4_t m{ Mask & 1 ? ~0u : 0u, Mask & 2 ? ~0u : 0u, Mask & 4 ? ~0u : 0u, Mask & 8 ? ~0u : 0u };
+        const pack result(vbslq_f32(m, b.v, v));
+        return result;
+    }
+
+    float operator[](std::size_t i) const
+    {
+        float t[4];
+        vst1q_f32(t, v);
+        return t[i];
+    }
+
+    float32x4_t v;
+};
+
+template<>
+struct mask<float, 4> {
+    uint32x4_t v;
+};
+
+inline auto operator+(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vaddq_f32(a.v, b.v)); }
+inline auto operator-(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vsubq_f32(a.v, b.v)); }
+inline auto operator*(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vmulq_f32(a.v, b.v)); }
+inline auto operator/(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vdivq_f32(a.v, b.v)); }
+inline auto operator-(const pack<float, 4>& a) { return pack<float, 4>(vnegq_f32(a.v)); }
+// explicit selects keep std::min/std::max semantics: b is returned only when it strictly wins
+inline auto min(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vbslq_f32(vcltq_f32(b.v, a.v), b.v, a.v)); }
+inline auto max(const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vbslq_f32(vcltq_f32(a.v, b.v), b.v, a.v)); }
+inline auto abs(const pack<float, 4>& a) { return pack<float, 4>(vabsq_f32(a.v)); }
+inline auto sqrt(const pack<float, 4>& a) { return pack<float, 4>(vsqrtq_f32(a.v)); }
+inline auto fmadd(const pack<float, 4>& a, const pack<float, 4>& b, const pack<float, 4>& c) { return pack<float, 4>(vfmaq_f32(c.v, a.v, b.v)); }
+inline auto operator<(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ vcltq_f32(a.v, b.v) }; }
+inline auto operator<=(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ vcleq_f32(a.v, b.v) }; }
+inline auto operator>(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ vcgtq_f32(a.v, b.v) }; }
+inline auto operator>=(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ vcgeq_f32(a.v, b.v) }; }
+inline auto operator==(const pack<float, 4>& a, const pack<float, 4>& b) { return mask<float, 4>{ vceqq_f32(a.v, b.v) }; }
+inline auto operator&(const mask<float, 4>& a, const mask<float, 4>& b) { return mask<float, 4>{ vandq_u32(a.v, b.v) }; }
+inline auto operator|(const mask<float, 4>& a, const mask<float, 4>& b) { return mask<float, 4>{ vorrq_u32(a.v, b.v) }; }
+inline auto select(const mask<float, 4>& m, const pack<float, 4>& a, const pack<float, 4>& b) { return pack<float, 4>(vbslq_f32(m.v, a.v, b.v)); }
+inline auto reduce_add(const pack<float, 4>& a) { return vaddvq_f32(a.v); }
+inline auto reduce_min(const pack<float, 4>& a) { return vminvq_f32(a.v); }
+inline auto reduce_max(const pack<float, 4>& a) { return vmaxvq_f32(a.v); }
+
+inline auto bitmask(const mask<float, 4>& m)
+{
+    const uint32x4_t bits{ 1, 2, 4, 8 };
+    const auto result = vaddvq_u32(vandq_u32(m.v, bits));
+    return result;
+}
+
+inline auto unzip(const pack<float, 4>& a, const pack<float, 4>& b)
+{
+    const auto u = vuzpq_f32(a.v, b.v);
+    const std::array<pack<float, 4>, 2> result{ pack<float, 4>(u.val[0]), pack<float, 4>(u.val[1]) };
+    return result;
+}
+
+inline auto zip(const pack<float, 4>& a, const pack<float, 4>& b)
+{
+    const auto z = vzipq_f32(a.v, b.v);
+    const std::array<pack<float, 4>, 2> result{ pack<float, 4>(z.val[0]), pack<float, 4>(z.val[1]) };
+    return result;
+}
+
+// vrsqrte is good to 8 bits, vrsqrts computes the Newton factor
+// (3 - a y^2) / 2 and two steps reach float precision
+inline auto rsqrt(const pack<float, 4>& a)
+{
+    auto y = vrsqrteq_f32(a.v);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a.v, y), y));
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a.v, y), y));
+    return pack<float, 4>(y);
+}
+
+inline auto ldexp(const pack<float, 4>& a, const pack<float, 4>& k)
+{
+    const auto scale = vshlq_n_s32(vaddq_s32(vcvtnq_s32_f32(k.v), vdupq_n_s32(127)), 23);
+    const auto result = a * pack<float, 4>(vreinterpretq_f32_s32(scale));
+    return result;
+}
+
+inline auto split_exponent(const pack<float, 4>& x)
+{
+    const auto b = vreinterpretq_u32_f32(x.v);
+    const auto m = vorrq_u32(vandq_u32(b, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f800000));
+    const auto e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(b, 23)), vdupq_n_s32(127));
+    return std::make_pair(pack<float, 4>(vreinterpretq_f32_u32(m)), pack<float, 4>(vcvtq_f32_s32(e)));
+}
+#endif
+
+#if defined(LUCMATH_SIMD_AVX2)
+template<>
+struct pack<double, 4> {
+    pack() = default;
+
+    pack(const double& t) :
+      v(_mm256_set1_pd(t)) {}
+
+    pack(const std::array<double, 4>& a) :
+      v(_mm256_loadu_pd(a.data())) {}
+
+    pack(const __m256d& r) :
+      v(r) {}
+
+    static auto load(const double* p)
+    {
+        const pack result(_mm256_loadu_pd(p));
+        return result;
+    }
+
+    auto store(double* p) const
+    {
+        _mm256_storeu_pd(p, v);
+    }
+
+    static auto load3(const double* p)
+    {
+        const auto xy = _mm_loadu_pd(p);
+        const auto z = _mm_load_sd(p + 2);
+        const pack result(_mm256_insertf128_pd(_mm256_castpd128_pd256(xy), z, 1));
+        return result;
+    }
+
+    auto store3(double* p) const
+    {
+        _mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+        _mm_store_sd(p + 2, _mm256_extractf128_pd(v, 1));
+    }
+
+    template<size_t I0, size_t I1, size_t I2, size_t I3>
+    auto shuffle() const
+    {
+        const pack result(_mm256_permute4x64_pd(v, int(I0 | (I1 << 2) | (I2 << 4) | (I3 << 6))));
+        return result;
+    }
+
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        const pack result(_mm256_blend_pd(v, b.v, Mask));
+        return result;
+    }
+
+    double operator[](std::size_t i) const
+    {
+        alignas(32) double t[4];
+        _mm256_store_pd(t, v);
+        return t[i];
+    }
+
+    __m256d v;
+};
+
+template<>
+struct mask<double, 4> {
+    __m256d v;
+};
+
+inline auto operator+(const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_add_pd(a.v, b.v)); }
+inline auto operator-(const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_sub_pd(a.v, b.v)); }
+inline auto operator*(const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_mul_pd(a.v, b.v)); }
+inline auto operator/(const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_div_pd(a.v, b.v)); }
+inline auto operator-(const pack<double, 4>& a) { return pack<double, 4>(_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))); }
+inline auto min(const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_min_pd(b.v, a.v)); }
+inline auto max(const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_max_pd(b.v, a.v)); }
+inline auto abs(const pack<double, 4>& a) { return pack<double, 4>(_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)); }
+inline auto sqrt(const pack<double, 4>& a) { return pack<double, 4>(_mm256_sqrt_pd(a.v)); }
+inline auto operator<(const pack<double, 4>& a, const pack<double, 4>& b) { return mask<double, 4>{ _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+inline auto operator<=(const pack<double, 4>& a, const pack<double, 4>& b) { return mask<double, 4>{ _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+inline auto operator>(const pack<double, 4>& a, const pack<double, 4>& b) { return mask<double, 4>{ _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+inline auto operator>=(const pack<double, 4>& a, const pack<double, 4>& b) { return mask<double, 4>{ _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+inline auto operator==(const pack<double, 4>& a, const pack<double, 4>& b) { return mask<double, 4>{ _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ) }; }
+inline auto operator&(const mask<double, 4>& a, const mask<double, 4>& b) { return mask<double, 4>{ _mm256_and_pd(a.v, b.v) }; }
+inline auto operator|(const mask<double, 4>& a, const mask<double, 4>& b) { return mask<double, 4>{ _mm256_or_pd(a.v, b.v) }; }
+inline auto bitmask(const mask<double, 4>& m) { return uint32_t(_mm256_movemask_pd(m.v)); }
+inline auto select(const mask<double, 4>& m, const pack<double, 4>& a, const pack<double, 4>& b) { return pack<double, 4>(_mm256_blendv_pd(b.v, a.v, m.v)); }
+
+inline auto fmadd(const pack<double, 4>& a, const pack<double, 4>& b, const pack<double, 4>& c)
+{
+#if defined(__FMA__)
+    return pack<double, 4>(_mm256_fmadd_pd(a.v, b.v, c.v));
+#else
+    return a * b + c;
+#endif
+}
+
+inline auto reduce_add(const pack<double, 4>& a)
+{
+    const auto s2 = _mm_add_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1));
+    const auto s1 = _mm_add_sd(s2, _mm_unpackhi_pd(s2, s2));
+    const auto result = _mm_cvtsd_f64(s1);
+    return result;
+}
+
+inline auto reduce_min(const pack<double, 4>& a)
+{
+    const auto s2 = _mm_min_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1));
+    const auto s1 = _mm_min_sd(s2, _mm_unpackhi_pd(s2, s2));
+    const auto result = _mm_cvtsd_f64(s1);
+    return result;
+}
+
+inline auto reduce_max(const pack<double, 4>& a)
+{
+    const auto s2 = _mm_max_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1));
+    const auto s1 = _mm_max_sd(s2, _mm_unpackhi_pd(s2, s2));
+    const auto result = _mm_cvtsd_f64(s1);
+    return result;
+}
+
+inline auto unzip(const pack<double, 4>& a, const pack<double, 4>& b)
+{
+    const auto even = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a.v, b.v), 0xd8);
+    const auto odd = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a.v, b.v), 0xd8);
+    const std::array<pack<double, 4>, 2> result{ pack<double, 4>(even), pack<double, 4>(odd) };
+    return result;
+}
+
+inline auto zip(const pack<double, 4>& a, const pack<double, 4>& b)
+{
+    const auto lo = _mm256_unpacklo_pd(a.v, b.v);
+    const auto hi = _mm256_unpackhi_pd(a.v, b.v);
+    const std::array<pack<double, 4>, 2> result{ pack<double, 4>(_mm256_permute2f128_pd(lo, hi, 0x20)),
+                                                 pack<double, 4>(_mm256_permute2f128_pd(lo, hi, 0x31)) };
+    return result;
+}
+// no double estimate below avx-512, the divide is exact and about as fast
+// as the three Newton steps a 12 bit float estimate would need
+inline auto rsqrt(const pack<double, 4>& a) { return pack<double, 4>(1.) / sqrt(a); }
+
+inline auto ldexp(const pack<double, 4>& a, const pack<double, 4>& k)
+{
+    const auto k64 = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k.v));
+    const auto scale = _mm256_slli_epi64(_mm256_add_epi64(k64, _mm256_set1_epi64x(1023)), 52);
+    const auto result = a * pack<double, 4>(_mm256_castsi256_pd(scale));
+    return result;
+}
+
+// the exponent field becomes a double by or-ing it under the bits of 2^52
+inline auto split_exponent(const pack<double, 4>& x)
+{
+    const auto b = _mm256_castpd_si256(x.v);
+    const auto m = _mm256_or_si256(_mm256_and_si256(b, _mm256_set1_epi64x(0x000fffffffffffff)), _mm256_set1_epi64x(0x3ff0000000000000));
+    const auto biased = _mm256_or_si256(_mm256_srli_epi64(b, 52), _mm256_set1_epi64x(0x4330000000000000));
+    const auto e = _mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_set1_pd(4503599627370496. + 1023.));
+    return std::make_pair(pack<double, 4>(_mm256_castsi256_pd(m)), pack<double, 4>(e));
+}
+
+template<>
+struct pack<float, 8> {
+    pack() = default;
+
+    pack(const float& t) :
+      v(_mm256_set1_ps(t)) {}
+
+    pack(const std::array<float, 8>& a) :
+      v(_mm256_loadu_ps(a.data())) {}
+
+    pack(const __m256& r) :
+      v(r) {}
+
+    static auto load(const float* p)
+    {
+        const pack result(_mm256_loadu_ps(p));
+        return result;
+    }
+
+    auto store(float* p) const
+    {
+        _mm256_storeu_ps(p, v);
+    }
+
+    template<size_t... I>
+    auto shuffle() const
+    {
+        alignas(32) static constexpr int32_t index[] = { int32_t(I)... };
+        const pack result(_mm256_permutevar8x32_ps(v, _mm256_load_si256(reinterpret_cast<const __m256i*>(index))));
+        return result;
+    }
+
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        const pack result(_mm256_blend_ps(v, b.v, Mask));
+        return result;
+    }
+
+    float operator[](std::size_t i) const
+    {
+        alignas(32) float t[8];
+        _mm256_store_ps(t, v);
+        return t[i];
+    }
+
+    __m256 v;
+};
+
+template<>
+struct mask<float, 8> {
+    __m256 v;
+};
+
+inline auto operator+(const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_add_ps(a.v, b.v)); }
+inline auto operator-(const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_sub_ps(a.v, b.v)); }
+inline auto operator*(const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_mul_ps(a.v, b.v)); }
+inline auto operator/(const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_div_ps(a.v, b.v)); }
+inline auto operator-(const pack<float, 8>& a) { return pack<float, 8>(_mm256_xor_ps(a.v, _mm256_set1_ps(-0.f))); }
+inline auto min(const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_min_ps(b.v, a.v)); }
+inline auto max(const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_max_ps(b.v, a.v)); }
+inline auto abs(const pack<float, 8>& a) { return pack<float, 8>(_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v)); }
+inline auto sqrt(const pack<float, 8>& a) { return pack<float, 8>(_mm256_sqrt_ps(a.v)); }
+inline auto operator<(const pack<float, 8>& a, const pack<float, 8>& b) { return mask<float, 8>{ _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline auto operator<=(const pack<float, 8>& a, const pack<float, 8>& b) { return mask<float, 8>{ _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline auto operator>(const pack<float, 8>& a, const pack<float, 8>& b) { return mask<float, 8>{ _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline auto operator>=(const pack<float, 8>& a, const pack<float, 8>& b) { return mask<float, 8>{ _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+inline auto operator==(const pack<float, 8>& a, const pack<float, 8>& b) { return mask<float, 8>{ _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; }
+inline auto operator&(const mask<float, 8>& a, const mask<float, 8>& b) { return mask<float, 8>{ _mm256_and_ps(a.v, b.v) }; }
+inline auto operator|(const mask<float, 8>& a, const mask<float, 8>& b) { return mask<float, 8>{ _mm256_or_ps(a.v, b.v) }; }
+inline auto bitmask(const mask<float, 8>& m) { return uint32_t(_mm256_movemask_ps(m.v)); }
+inline auto select(const mask<float, 8>& m, const pack<float, 8>& a, const pack<float, 8>& b) { return pack<float, 8>(_mm256_blendv_ps(b.v, a.v, m.v)); }
+
+inline auto fmadd(const pack<float, 8>& a, const pack<float, 8>& b, const pack<float, 8>& c)
+{
+#if defined(__FMA__)
+    return pack<float, 8>(_mm256_fmadd_ps(a.v, b.v, c.v));
+#else
+    return a * b + c;
+#endif
+}
+
+inline auto reduce_add(const pack<float, 8>& a)
+{
+    const pack<float, 4> s4(_mm_add_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1)));
+    return reduce_add(s4);
+}
+
+inline auto reduce_min(const pack<float, 8>& a)
+{
+    const pack<float, 4> s4(_mm_min_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1)));
+    return reduce_min(s4);
+}
+
+inline auto reduce_max(const pack<float, 8>& a)
+{
+    const pack<float, 4> s4(_mm_max_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1)));
+    return reduce_max(s4);
+}
+
+inline auto unzip(const pack<float, 8>& a, const pack<float, 8>& b)
+{
+    const auto even = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0))), 0xd8));
+    const auto odd = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1))), 0xd8));
+    const std::array<pack<float, 8>, 2> result{ pack<float, 8>(even), pack<float, 8>(odd) };
+    return result;
+}
+
+inline auto zip(const pack<float, 8>& a, const pack<float, 8>& b)
+{
+    const auto lo = _mm256_unpacklo_ps(a.v, b.v);
+    const auto hi = _mm256_unpackhi_ps(a.v, b.v);
+    const std::array<pack<float, 8>, 2> result{ pack<float, 8>(_mm256_permute2f128_ps(lo, hi, 0x20)),
+                                                pack<float, 8>(_mm256_permute2f128_ps(lo, hi, 0x31)) };
+    return result;
+}
+
+inline auto rsqrt(const pack<float, 8>& a)
+{
+    const pack<float, 8> y(_mm256_rsqrt_ps(a.v));
+    const auto result = y * (pack<float, 8>(1.5f) - pack<float, 8>(.5f) * a * y * y);
+    return result;
+}
+
+inline auto ldexp(const pack<float, 8>& a, const pack<float, 8>& k)
+{
+    const auto scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(k.v), _mm256_set1_epi32(127)), 23);
+    const auto result = a * pack<float, 8>(_mm256_castsi256_ps(scale));
+    return result;
+}
+
+inline auto split_exponent(const pack<float, 8>& x)
+{
+    const auto b = _mm256_castps_si256(x.v);
+    const auto m = _mm256_or_si256(_mm256_and_si256(b, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000));
+    const auto e = _mm256_sub_epi32(_mm256_srli_epi32(b, 23), _mm256_set1_epi32(127));
+    return std::make_pair(pack<float, 8>(_mm256_castsi256_ps(m)), pack<float, 8>(_mm256_cvtepi32_ps(e)));
+}
+#endif
+
+#if defined(LUCMATH_SIMD_AVX512)
+template<>
+struct pack<float, 16> {
+    pack() = default;
+
+    pack(const float& t) :
+      v(_mm512_set1_ps(t)) {}
+
+    pack(const std::array<float, 16>& a) :
+      v(_mm512_loadu_ps(a.data())) {}
+
+    pack(const __m512& r) :
+      v(r) {}
+
+    static auto load(const float* p)
+    {
+        const pack result(_mm512_loadu_ps(p));
+        return result;
+    }
+
+    auto store(float* p) const
+    {
+        _mm512_storeu_ps(p, v);
+    }
+
+    template<size_t... I>
+    auto shuffle() const
+    {
+        alignas(64) static constexpr int32_t index[] = { int32_t(I)... };
+        const pack result(_mm512_maskz_permutexvar_ps(__mmask16(0xffff), _mm512_load_si512(index), v));
+        return result;
+    }
+
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        const pack result(_mm512_mask_blend_ps(__mmask16(Mask), v, b.v));
+        return result;
+    }
+
+    float operator[](std::size_t i) const
+    {
+        alignas(64) float t[16];
+        _mm512_store_ps(t, v);
+        return t[i];
+    }
+
+    __m512 v;
+};
+
+template<>
+struct mask<float, 16> {
+    __mmask16 v;
+};
+
+inline auto operator+(const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_add_ps(a.v, b.v)); }
+inline auto operator-(const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_sub_ps(a.v, b.v)); }
+inline auto operator*(const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_mul_ps(a.v, b.v)); }
+inline auto operator/(const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_div_ps(a.v, b.v)); }
+inline auto operator-(const pack<float, 16>& a) { return pack<float, 16>(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(int(0x80000000))))); }
+inline auto min(const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_min_ps(b.v, a.v)); }
+inline auto max(const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_max_ps(b.v, a.v)); }
+inline auto abs(const pack<float, 16>& a) { return pack<float, 16>(_mm512_abs_ps(a.v)); }
+inline auto sqrt(const pack<float, 16>& a) { return pack<float, 16>(_mm512_sqrt_ps(a.v)); }
+inline auto fmadd(const pack<float, 16>& a, const pack<float, 16>& b, const pack<float, 16>& c) { return pack<float, 16>(_mm512_fmadd_ps(a.v, b.v, c.v)); }
+inline auto operator<(const pack<float, 16>& a, const pack<float, 16>& b) { return mask<float, 16>{ _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ) }; }
+inline auto operator<=(const pack<float, 16>& a, const pack<float, 16>& b) { return mask<float, 16>{ _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ) }; }
+inline auto operator>(const pack<float, 16>& a, const pack<float, 16>& b) { return mask<float, 16>{ _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ) }; }
+inline auto operator>=(const pack<float, 16>& a, const pack<float, 16>& b) { return mask<float, 16>{ _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ) }; }
+inline auto operator==(const pack<float, 16>& a, const pack<float, 16>& b) { return mask<float, 16>{ _mm512_cmp_ps_mask(a.v, b.v, _CMP_EQ_OQ) }; }
+inline auto operator&(const mask<float, 16>& a, const mask<float, 16>& b) { return mask<float, 16>{ __mmask16(a.v & b.v) }; }
+inline auto operator|(const mask<float, 16>& a, const mask<float, 16>& b) { return mask<float, 16>{ __mmask16(a.v | b.v) }; }
+inline auto bitmask(const mask<float, 16>& m) { return uint32_t(m.v); }
+inline auto select(const mask<float, 16>& m, const pack<float, 16>& a, const pack<float, 16>& b) { return pack<float, 16>(_mm512_mask_blend_ps(m.v, b.v, a.v)); }
+inline auto reduce_add(const pack<float, 16>& a) { return _mm512_reduce_add_ps(a.v); }
+inline auto reduce_min(const pack<float, 16>& a) { return _mm512_reduce_min_ps(a.v); }
+inline auto reduce_max(const pack<float, 16>& a) { return _mm512_reduce_max_ps(a.v); }
+
+inline auto unzip(const pack<float, 16>& a, const pack<float, 16>& b)
+{
+    const auto even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const auto odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    const std::array<pack<float, 16>, 2> result{ pack<float, 16>(_mm512_permutex2var_ps(a.v, even, b.v)),
+                                                 pack<float, 16>(_mm512_permutex2var_ps(a.v, odd, b.v)) };
+    return result;
+}
+
+inline auto zip(const pack<float, 16>& a, const pack<float, 16>& b)
+{
+    const auto lo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const auto hi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    const std::array<pack<float, 16>, 2> result{ pack<float, 16>(_mm512_permutex2var_ps(a.v, lo, b.v)),
+                                                 pack<float, 16>(_mm512_permutex2var_ps(a.v, hi, b.v)) };
+    return result;
+}
+
+// rsqrt14 is good to 14 bits, one Newton step reaches float precision
+inline auto rsqrt(const pack<float, 16>& a)
+{
+    const pack<float, 16> y(_mm512_rsqrt14_ps(a.v));
+    const auto result = y * (pack<float, 16>(1.5f) - pack<float, 16>(.5f) * a * y * y);
+    return result;
+}
+
+inline auto ldexp(const pack<float, 16>& a, const pack<float, 16>& k) { return pack<float, 16>(_mm512_scalef_ps(a.v, k.v)); }
+
+inline auto split_exponent(const pack<float, 16>& x)
+{
+    return std::make_pair(pack<float, 16>(_mm512_getmant_ps(x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero)),
+                          pack<float, 16>(_mm512_getexp_ps(x.v)));
+}
+
+template<>
+struct pack<double, 8> {
+    pack() = default;
+
+    pack(const double& t) :
+      v(_mm512_set1_pd(t)) {}
+
+    pack(const std::array<double, 8>& a) :
+      v(_mm512_loadu_pd(a.data())) {}
+
+    pack(const __m512d& r) :
+      v(r) {}
+
+    static auto load(const double* p)
+    {
+        const pack result(_mm512_loadu_pd(p));
+        return result;
+    }
+
+    auto store(double* p) const
+    {
+        _mm512_storeu_pd(p, v);
+    }
+
+    template<size_t... I>
+    auto shuffle() const
+    {
+        alignas(64) static constexpr int64_t index[] = { int64_t(I)... };
+        const pack result(_mm512_maskz_permutexvar_pd(__mmask8(0xff), _mm512_load_si512(index), v));
+        return result;
+    }
+
+    template<uint32_t Mask>
+    auto blend(const pack& b) const
+    {
+        const pack result(_mm512_mask_blend_pd(__mmask8(Mask), v, b.v));
+        return result;
+    }
+
+    double operator[](std::size_t i) const
+    {
+        alignas(64) double t[8];
+        _mm512_store_pd(t, v);
+        return t[i];
+    }
+
+    __m512d v;
+};
+
+template<>
+struct mask<double, 8> {
+    __mmask8 v;
+};
+
+inline auto operator+(const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_add_pd(a.v, b.v)); }
+inline auto operator-(const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_sub_pd(a.v, b.v)); }
+inline auto operator*(const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_mul_pd(a.v, b.v)); }
+inline auto operator/(const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_div_pd(a.v, b.v)); }
+inline auto operator-(const pack<double, 8>& a) { return pack<double, 8>(_mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a.v), _mm512_set1_epi64(int64_t(0x8000000000000000ull))))); }
+inline auto min(const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_min_pd(b.v, a.v)); }
+inline auto max(const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_max_pd(b.v, a.v)); }
+inline auto abs(const pack<double, 8>& a) { return pack<double, 8>(_mm512_abs_pd(a.v)); }
+inline auto sqrt(const pack<double, 8>& a) { return pack<double, 8>(_mm512_sqrt_pd(a.v)); }
+inline auto fmadd(const pack<double, 8>& a, const pack<double, 8>& b, const pack<double, 8>& c) { return pack<double, 8>(_mm512_fmadd_pd(a.v, b.v, c.v)); }
+inline auto operator<(const pack<double, 8>& a, const pack<double, 8>& b) { return mask<double, 8>{ _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ) }; }
+inline auto operator<=(const pack<double, 8>& a, const pack<double, 8>& b) { return mask<double, 8>{ _mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ) }; }
+inline auto operator>(const pack<double, 8>& a, const pack<double, 8>& b) { return mask<double, 8>{ _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ) }; }
+inline auto operator>=(const pack<double, 8>& a, const pack<double, 8>& b) { return mask<double, 8>{ _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ) }; }
+inline auto operator==(const pack<double, 8>& a, const pack<double, 8>& b) { return mask<double, 8>{ _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ) }; }
+inline auto operator&(const mask<double, 8>& a, const mask<double, 8>& b) { return mask<double, 8>{ __mmask8(a.v & b.v) }; }
+inline auto operator|(const mask<double, 8>& a, const mask<double, 8>& b) { return mask<double, 8>{ __mmask8(a.v | b.v) }; }
+inline auto bitmask(const mask<double, 8>& m) { return uint32_t(m.v); }
+inline auto select(const mask<double, 8>& m, const pack<double, 8>& a, const pack<double, 8>& b) { return pack<double, 8>(_mm512_mask_blend_pd(m.v, b.v, a.v)); }
+inline auto reduce_add(const pack<double, 8>& a) { return _mm512_reduce_add_pd(a.v); }
+inline auto reduce_min(const pack<double, 8>& a) { return _mm512_reduce_min_pd(a.v); }
+inline auto reduce_max(const pack<double, 8>& a) { return _mm512_reduce_max_pd(a.v); }
+
+inline auto unzip(const pack<double, 8>& a, const pack<double, 8>& b)
+{
+    const auto even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    const auto odd = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+    const std::array<pack<double, 8>, 2> result{ pack<double, 8>(_mm512_permutex2var_pd(a.v, even, b.v)),
+                                                 pack<double, 8>(_mm512_permutex2var_pd(a.v, odd, b.v)) };
+    return result;
+}
+
+inline auto zip(const pack<double, 8>& a, const pack<double, 8>& b)
+{
+    const auto lo = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    const auto hi = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    const std::array<pack<double, 8>, 2> result{ pack<double, 8>(_mm512_permutex2var_pd(a.v, lo, b.v)),
+                                                 pack<double, 8>(_mm512_permutex2var_pd(a.v, hi, b.v)) };
+    return result;
+}
+
+// two Newton steps take the 14 bit estimate past double precision
+inline auto rsqrt(const pack<double, 8>& a)
+{
+    auto y = pack<double, 8>(_mm512_rsqrt14_pd(a.v));
+    y = y * (pack<double, 8>(1.5) - pack<double, 8>(.5) * a * y * y);
+    y = y * (pack<double, 8>(1.5) - pack<double, 8>(.5) * a * y * y);
+    return y;
+}
+
+inline auto ldexp(const pack<double, 8>& a, const pack<double, 8>& k) { return pack<double, 8>(_mm512_scalef_pd(a.v, k.v)); }
+
+inline auto split_exponent(const pack<double, 8>& x)
+{
+    return std::make_pair(pack<double, 8>(_mm512_getmant_pd(x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero)),
+                          pack<double, 8>(_mm512_getexp_pd(x.v)));
+}
+#endif
+
+template<typename T, size_t W>
+constexpr auto operator+(const pack<T, W>& a, const T& b)
+{
+    return a + pack<T, W>(b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator-(const pack<T, W>& a, const T& b)
+{
+    return a - pack<T, W>(b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator*(const pack<T, W>& a, const T& b)
+{
+    return a * pack<T, W>(b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator/(const pack<T, W>& a, const T& b)
+{
+    return a / pack<T, W>(b);
+}
+
+template<typename T, size_t W>
+constexpr auto operator*(const T& a, const pack<T, W>& b)
+{
+    return pack<T, W>(a) * b;
+}
+
+template<size_t... I, typename T, size_t W>
+auto shuffle(const pack<T, W>& a)
+{
+    const auto result = a.template shuffle<I...>();
+    return result;
+}
+
+template<uint32_t Mask, typename T, size_t W>
+auto blend(const pack<T, W>& a, const pack<T, W>& b)
+{
+    const auto result = a.template blend<Mask>(b);
+    return result;
+}
+
+// AoS <-> SoA for N interleaved components. When N and W share no factor
+// every component of a packet lands in a distinct lane across the N
+// registers, so one blend chain plus one permute per component is enough.
+
+template<size_t N, size_t W>
+constexpr auto interleave_mask(size_t k, size_t r)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < W; i++)
+        if ((i * N + k) / W == r)
+            result |= uint32_t(1) << ((i * N + k) % W);
+    return result;
+}
+
+template<size_t N, size_t W>
+constexpr auto interleave_source(size_t k, size_t pos)
+{
+    size_t result = 0;
+    for (size_t i = 0; i < W; i++)
+        if ((i * N + k) % W == pos)
+            result = i;
+    return result;
+}
+
+template<size_t N, size_t W>
+constexpr auto deinterleave_mask(size_t k, size_t r)
+{
+    uint32_t result = 0;
+    for (size_t pos = 0; pos < W; pos++)
+        if ((r * W + pos) % N == k)
+            result |= uint32_t(1) << pos;
+    return result;
+}
+
+// blends register R.. into acc at the lanes holding component K
+template<size_t N, size_t W, size_t K, size_t R = 1, typename T>
+auto gather_component(const std::array<pack<T, W>, N>& regs, const pack<T, W>& acc)
+{
+    if constexpr (R == N)
+        return acc;
+    else
+        return gather_component<N, W, K, R + 1>(regs, blend<interleave_mask<N, W>(K, R)>(acc, regs[R]));
+}
+
+template<size_t N, size_t W, size_t K, typename T, size_t... I>
+auto load_component(const std::array<pack<T, W>, N>& regs, std::index_sequence<I...>)
+{
+    const auto result = shuffle<((I * N + K) % W)...>(gather_component<N, W, K>(regs, regs[0]));
+    return result;
+}
+
+template<size_t N, size_t W, typename T, size_t... K>
+auto load_components(const std::array<pack<T, W>, N>& regs, std::index_sequence<K...>)
+{
+    const std::array<pack<T, W>, N> result{ load_component<N, W, K>(regs, std::make_index_sequence<W>{})... };
+    return result;
+}
+
+template<size_t N, size_t W, size_t K, typename T, size_t... I>
+auto place_component(const pack<T, W>& component, std::index_sequence<I...>)
+{
+    const auto result = shuffle<interleave_source<N, W>(K, I)...>(component);
+    return result;
+}
+
+template<size_t N, size_t W, typename T, size_t... K>
+auto place_components(const std::array<pack<T, W>, N>& components, std::index_sequence<K...>)
+{
+    const std::array<pack<T, W>, N> result{ place_component<N, W, K>(components[K], std::make_index_sequence<W>{})... };
+    return result;
+}
+
+// blends the placed components into output register R
+template<size_t N, size_t W, size_t R, size_t K = 1, typename T>
+auto scatter_register(const std::array<pack<T, W>, N>& placed, const pack<T, W>& acc)
+{
+    if constexpr (K == N)
+        return acc;
+    else
+        return scatter_register<N, W, R, K + 1>(placed, blend<deinterleave_mask<N, W>(K, R)>(acc, placed[K]));
+}
+
+template<size_t N, size_t W, typename T, size_t... R>
+auto store_registers(const std::array<pack<T, W>, N>& placed, T* p, std::index_sequence<R...>)
+{
+    (scatter_register<N, W, R>(placed, placed[0]).store(p + R * W), ...);
+}
+
+// When N divides W every register holds W / N whole packets and component
+// K sits on the same lanes of all N registers. Rotating register R by R
+// lanes first moves it onto lanes congruent to K + R mod N, distinct again,
+// which leaves the same blend chain plus one permute per component.
+
+template<size_t N, size_t W>
+constexpr auto block_mask(size_t k, size_t r)
+{
+    uint32_t result = 0;
+    for (size_t pos = 0; pos < W; pos++)
+        if (pos % N == (k + r) % N)
+            result |= uint32_t(1) << pos;
+    return result;
+}
+
+// lane of component k of packet i once its register has been rotated
+template<size_t N, size_t W>
+constexpr auto block_lane(size_t k, size_t i)
+{
+    constexpr auto B = W / N;
+    const auto result = ((i % B) * N + k + i / B) % W;
+    return result;
+}
+
+template<size_t N, size_t W>
+constexpr auto block_source(size_t k, size_t pos)
+{
+    size_t result = 0;
+    for (size_t i = 0; i < W; i++)
+        if (block_lane<N, W>(k, i) == pos)
+            result = i;
+    return result;
+}
+
+// lane I takes lane I + S
+template<size_t S, typename T, size_t W, size_t... I>
+auto rotate_lanes(const pack<T, W>& a, std::index_sequence<I...>)
+{
+    const auto result = shuffle<((I + S) % W)...>(a);
+    return result;
+}
+
+template<size_t N, size_t W, typename T, size_t... R>
+auto rotate_registers(const std::array<pack<T, W>, N>& regs, std::index_sequence<R...>)
+{
+    const std::array<pack<T, W>, N> result{ rotate_lanes<(W - R) % W>(regs[R], std::make_index_sequence<W>{})... };
+    return result;
+}
+
+template<size_t N, size_t W, size_t K, size_t R = 1, typename T>
+auto gather_block(const std::array<pack<T, W>, N>& rotated, const pack<T, W>& acc)
+{
+    if constexpr (R == N)
+        return acc;
+    else
+        return gather_block<N, W, K, R + 1>(rotated, blend<block_mask<N, W>(K, R)>(acc, rotated[R]));
+}
+
+template<size_t N, size_t W, size_t K, typename T, size_t... I>
+auto load_block(const std::array<pack<T, W>, N>& rotated, std::index_sequence<I...>)
+{
+    const auto result = shuffle<block_lane<N, W>(K, I)...>(gather_block<N, W, K>(rotated, rotated[0]));
+    return result;
+}
+
+template<size_t N, size_t W, typename T, size_t... K>
+auto load_blocks(const std::array<pack<T, W>, N>& regs, std::index_sequence<K...>)
+{
+    const auto rotated = rotate_registers<N, W>(regs, std::make_index_sequence<N>{});
+    const std::array<pack<T, W>, N> result{ load_block<N, W, K>(rotated, std::make_index_sequence<W>{})... };
+    return result;
+}
+
+template<size_t N, size_t W, size_t K, typename T, size_t... I>
+auto place_block(const pack<T, W>& component, std::index_sequence<I...>)
+{
+    const auto result = shuffle<block_source<N, W>(K, I)...>(component);
+    return result;
+}
+
+// blends the placed components into rotated register R
+template<size_t N, size_t W, size_t R, size_t K = 1, typename T>
+auto scatter_block(const std::array<pack<T, W>, N>& placed, const pack<T, W>& acc)
+{
+    if constexpr (K == N)
+        return acc;
+    else
+        return scatter_block<N, W, R, K + 1>(placed, blend<block_mask<N, W>(K, R)>(acc, placed[K]));
+}
+
+template<size_t N, size_t W, typename T, size_t... K>
+auto place_blocks(const std::array<pack<T, W>, N>& components, std::index_sequence<K...>)
+{
+    const std::array<pack<T, W>, N> result{ place_block<N, W, K>(components[K], std::make_index_sequence<W>{})... };
+    return result;
+}
+
+template<size_t N, size_t W, typename T, size_t... R>
+auto store_blocks(const std::array<pack<T, W>, N>& components, T* p, std::index_sequence<R...>)
+{
+    const auto placed = place_blocks<N, W>(components, std::make_index_sequence<N>{});
+    (rotate_lanes<R>(scatter_block<N, W, R>(placed, placed[0]), std::make_index_sequence<W>{}).store(p + R * W), ...);
+}
+
+// two components take one two-register unzip or zip, the general paths
+// below would spend a rotate and blends on them
+
+template<size_t N, size_t W, typename T>
+auto load_interleaved(const T* p)
+{
+    std::array<pack<T, W>, N> result;
+    if constexpr (N == 2)
+        result = unzip(pack<T, W>::load(p), pack<T, W>::load(p + W));
+    else if constexpr (std::gcd(N, W) == 1) {
+        std::array<pack<T, W>, N> regs;
+        for (size_t r = 0; r < N; r++)
+            regs[r] = pack<T, W>::load(p + r * W);
+        result = load_components<N, W>(regs, std::make_index_sequence<N>{});
+    }
+    else if constexpr (W % N == 0) {
+        std::array<pack<T, W>, N> regs;
+        for (size_t r = 0; r < N; r++)
+            regs[r] = pack<T, W>::load(p + r * W);
+        result = load_blocks<N, W>(regs, std::make_index_sequence<N>{});
+    }
+    else {
+        std::array<std::array<T, W>, N> lanes;
+        for (size_t i = 0; i < W; i++)
+            for (size_t k = 0; k < N; k++)
+                lanes[k][i] = p[i * N + k];
+        for (size_t k = 0; k < N; k++)
+            result[k] = pack<T, W>(lanes[k]);
+    }
+    return result;
+}
+
+template<size_t N, size_t W, typename T>
+auto store_interleaved(const std::array<pack<T, W>, N>& components, T* p)
+{
+    if constexpr (N == 2) {
+        const auto zipped = zip(components[0], components[1]);
+        zipped[0].store(p);
+        zipped[1].store(p + W);
+    }
+    else if constexpr (std::gcd(N, W) == 1) {
+        const auto placed = place_components<N, W>(components, std::make_index_sequence<N>{});
+        store_registers<N, W>(placed, p, std::make_index_sequence<N>{});
+    }
+    else if constexpr (W % N == 0)
+        store_blocks<N, W>(components, p, std::make_index_sequence<N>{});
+    else {
+        std::array<std::array<T, W>, N> lanes;
+        for (size_t k = 0; k < N; k++)
+            components[k].store(lanes[k].data());
+        for (size_t i = 0; i < W; i++)
+            for (size_t k = 0; k < N; k++)
+                p[i * N + k] = lanes[k][i];
+    }
+}
+
+template<typename T, size_t W>
+auto any(const mask<T, W>& m)
+{
+    return bitmask(m) != 0;
+}
+
+template<typename T, size_t W>
+auto all(const mask<T, W>& m)
+{
+    constexpr uint32_t full = W >= 32 ? ~uint32_t(0) : (uint32_t(1) << W) - 1;
+    return bitmask(m) == full;
+}
+
+template<typename T, size_t W>
+auto none(const mask<T, W>& m)
+{
+    return bitmask(m) == 0;
+}
+
+// polynomial sin, cos and acos on lanes, for kernels that would otherwise
+// call libm once per lane
+
+// c[0] + x * (c[1] + x * (...))
+template<typename T, size_t W, size_t M>
+inline auto horner(const pack<T, W>& x, const std::array<T, M>& c)
+{
+    auto result = pack<T, W>(c[M - 1]);
+    for (size_t i = M - 1; i-- > 0;)
+        result = fmadd(result, x, pack<T, W>(c[i]));
+    return result;
+}
+
+// x rounded to the nearest integer, adding 1.5 * 2^digits pushes the
+// fraction out of the mantissa, valid while |x| < 2^(digits - 1)
+template<typename T, size_t W>
+inline auto round_nearest(const pack<T, W>& x)
+{
+    constexpr auto shifter = T(1.5) * T(uint64_t(1) << (std::numeric_limits<T>::digits - 1));
+    const auto result = (x + pack<T, W>(shifter)) - pack<T, W>(shifter);
+    return result;
+}
+
+// x - q * pi/2 in [-pi/4, pi/4] and the quadrant q. pi/2 is split so the
+// leading products stay exact even without fma, four parts for float and
+// three for double. Accurate while |x| < 1e5, for float without fma while
+// |x| < 8192
+template<typename T, size_t W>
+inline auto reduce_half_pi(const pack<T, W>& x)
+{
+    using lane = pack<T, W>;
+    const auto q = round_nearest(x * lane(T(2) * std::numbers::inv_pi_v<T>));
+    if constexpr (std::is_same_v<T, float>) {
+        const auto r = fmadd(q, lane(-1.5703125f), x);
+        const auto r2 = fmadd(q, lane(-4.83751296997070312500e-4f), r);
+        const auto r3 = fmadd(q, lane(-7.54953362047672271729e-8f), r2);
+        return std::make_pair(fmadd(q, lane(-2.56334406825708960298e-12f), r3), q);
+    }
+    else {
+        const auto r = fmadd(q, lane(-1.57079625129699707031), x);
+        const auto r2 = fmadd(q, lane(-7.54978941586159635336e-8), r);
+        return std::make_pair(fmadd(q, lane(-5.390302858158119053e-15), r2), q);
+    }
+}
+
+// sin of q pi/2 + r from the series of r, cos is the same one quadrant on.
+// sin and cos trade places on odd q and the sign flips for q = 2, 3 mod 4.
+// With m = q mod 4 in [-2, 2] both flags are small polynomials in m that
+// are exactly 0 or 1, so lanes pick without masks and scalars without
+// branches
+template<typename T, size_t W>
+inline auto place_quadrant(const pack<T, W>& q, const pack<T, W>& sr, const pack<T, W>& cr)
+{
+    using lane = pack<T, W>;
+    const auto one = lane(T(1));
+    const auto m = q - lane(T(4)) * round_nearest(q * lane(T(.25)));
+    const auto m2 = m * m;
+    const auto two = m2 * (m2 - one) * lane(T(1) / T(12));
+    const auto odd = m2 - lane(T(4)) * two;
+    const auto negative = fmadd(odd * lane(T(.5)), one - m, two);
+    const auto s = fmadd(odd, cr, (one - odd) * sr);
+    const auto result = s * fmadd(lane(T(-2)), negative, one);
+    return result;
+}
+
+// sin on [-pi/4, pi/4], the Cephes minimax polynomial through x^7 for
+// float and the odd Taylor series through x^17 for double
+template<typename T, size_t W>
+inline auto sin_reduced(const pack<T, W>& r)
+{
+    const auto r2 = r * r;
+    if constexpr (std::is_same_v<T, float>) {
+        constexpr std::array<T, 3> c{ -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f };
+        return fmadd(r * r2, horner(r2, c), r);
+    }
+    else {
+        constexpr std::array<T, 8> c{ -1. / 6., 1. / 120., -1. / 5040., 1. / 362880., -1. / 39916800., 1. / 6227020800.,
+                                      -1. / 1307674368000., 1. / 355687428096000. };
+        return fmadd(r * r2, horner(r2, c), r);
+    }
+}
+
+// cos on [-pi/4, pi/4], the Cephes minimax polynomial through x^8 for
+// float and the even Taylor series through x^16 for double
+template<typename T, size_t W>
+inline auto cos_reduced(const pack<T, W>& r)
+{
+    const auto r2 = r * r;
+    if constexpr (std::is_same_v<T, float>) {
+        constexpr std::array<T, 3> c{ 4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f };
+        return fmadd(r2 * r2, horner(r2, c), fmadd(r2, pack<T, W>(-.5f), pack<T, W>(1.f)));
+    }
+    else {
+        constexpr std::array<T, 9> c{ 1., -1. / 2., 1. / 24., -1. / 720., 1. / 40320., -1. / 3628800., 1. / 479001600.,
+                                      -1. / 87178291200., 1. / 20922789888000. };
+        return horner(r2, c);
+    }
+}
+
+// both series run on every lane, the quadrant picks one. Within 2.4 ulp of
+// the true value, also next to the zeros
+template<typename T, size_t W>
+inline auto sin(const pack<T, W>& x)
+{
+    const auto [r, q] = reduce_half_pi(x);
+    const auto result = place_quadrant(q, sin_reduced(r), cos_reduced(r));
+    return result;
+}
+
+template<typename T, size_t W>
+inline auto cos(const pack<T, W>& x)
+{
+    const auto [r, q] = reduce_half_pi(x);
+    const auto result = place_quadrant(q + pack<T, W>(T(1)), sin_reduced(r), cos_reduced(r));
+    return result;
+}
+
+// Abramowitz and Stegun 4.4.46, sqrt(1 - |x|) times a degree 7 polynomial
+// within 2e-8 of acos(|x|). Double lanes take one Newton step on top, on
+// sin(t) = sqrt(1 - x^2) near |x| = 1 and on cos(t) = |x| elsewhere, so
+// the step never divides by a vanishing derivative
+template<typename T, size_t W>
+inline auto acos(const pack<T, W>& x)
+{
+    using lane = pack<T, W>;
+    constexpr std::array<T, 8> c{ T(1.5707963050), T(-0.2145988016), T(0.0889789874), T(-0.0501743046),
+                                  T(0.0308918810), T(-0.0170881256), T(0.0066700901), T(-0.0012624911) };
+    const auto a = abs(x);
+    auto t = sqrt(lane(T(1)) - a) * horner(a, c);
+    if constexpr (!std::is_same_v<T, float>) {
+        const auto s = sqrt((lane(T(1)) - a) * (lane(T(1)) + a));
+        const auto near_one = a > lane(T(.5));
+        const auto step = select(near_one, (s - sin(t)) / a, (cos(t) - a) / s);
+        t = t + step;
+    }
+    const auto result = select(x < lane(T(0)), lane(std::numbers::pi_v<T>) - t, t);
+    return result;
+}
+
+// runs of n contiguous scalars, shared by the long array backed vectors and
+// dynvector. Elementwise loops are left to the auto-vectorizer, a reduction
+// keeps lane accumulators where intrinsics back the native width
+#if defined(LUCMATH_SIMD_AVX2) || defined(LUCMATH_SIMD_AVX512)
+template<typename T>
+inline constexpr bool native_pack = std::is_same_v<T, float> || std::is_same_v<T, double>;
+#elif defined(LUCMATH_SIMD_SSE41) || defined(LUCMATH_SIMD_NEON)
+template<typename T>
+inline constexpr bool native_pack = std::is_same_v<T, float>;
+#else
+template<typename T>
+inline constexpr bool native_pack = false;
+#endif
+
+template<typename T, typename F>
+constexpr auto apply_n(T* out, size_t n, F&& f)
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = f(i);
+}
+
+template<typename T>
+auto dot_n(const T* a, const T* b, size_t n)
+{
+    T result(0);
+    size_t body = 0;
+    if constexpr (native_pack<T>) {
+        constexpr auto W = native_width<T>;
+        body = n / W * W;
+        pack<T, W> acc(T(0));
+        for (size_t i = 0; i < body; i += W)
+            acc = fmadd(pack<T, W>::load(a + i), pack<T, W>::load(b + i), acc);
+        result = reduce_add(acc);
+    }
+    else {
+        // sixteen independent sums, wide enough for the vectorizer to
+        // keep them in registers instead of reducing in order
+        constexpr size_t K = 16;
+        body = n / K * K;
+        std::array<T, K> acc{};
+        for (size_t i = 0; i < body; i += K)
+            for (size_t k = 0; k < K; k++)
+                acc[k] += a[i + k] * b[i + k];
+        for (size_t k = 0; k < K; k++)
+            result += acc[k];
+    }
+    for (size_t i = body; i < n; i++)
+        result += a[i] * b[i];
+    return result;
+}
+
+} // namespace simd
+} // namespace math
+
+#endif /* SIMD_MATH_H */
@@ -0,0 +1,263 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SUMMATION_MATH_H
+#define SUMMATION_MATH_H
+
+#include "vector.hpp"
+#include "dekker.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <span>
+
+namespace math {
+
+// Ogita, Rump and Oishi's compensated sums. sum2 and dot2 are as accurate as
+// accumulating in twice the working precision and rounding once, sumk and
+// dotk as K-fold precision. Floats are widened to double first, where their
+// products are exact
+
+template<typename T>
+concept compensated_scalar = std::same_as<T, float> || std::same_as<T, double>;
+
+// spans at least this long are split over the thread pool
+inline constexpr size_t compensated_parallel_threshold = size_t(1) << 18;
+
+// double lanes have registers from avx2 up, elsewhere one scalar chain runs
+// as fast as the dependency chain of a plain sum
+#if defined(LUCMATH_SIMD_AVX2)
+inline constexpr size_t compensated_width = simd::native_width<double>;
+#else
+inline constexpr size_t compensated_width = 1;
+#endif
+
+// the vertical SumK, a summand passes down K - 1 two-sum levels that each
+// keep the rounding error of the level above, what falls out of the last
+// level is summed plainly. V is double or a pack of independent lanes
+template<size_t K, typename V = double>
+struct compensated_sum {
+    static_assert(K >= 2);
+
+    // x enters at level first and skips the levels above it
+    constexpr auto add(V x, size_t first = 0)
+    {
+        for (size_t j = first; j < K - 1; j++) {
+            const auto e = dekker_add12(s[j], x);
+            s[j] = e.h;
+            x = e.l;
+        }
+        c = c + x;
+    }
+
+    // the rounding error of a product is a level smaller than the product,
+    // for K = 2 this is Dot2
+    constexpr auto add_product(const V& a, const V& b)
+    {
+        const auto p = dekker_mul12(a, b);
+        add(p.h);
+        add(p.l, 1);
+    }
+
+    constexpr auto merge(const compensated_sum& b)
+    {
+        for (size_t j = 0; j < K - 1; j++)
+            add(b.s[j], j);
+        c = c + b.c;
+    }
+
+    // after cancellation a lower level can outgrow the ones above, so the
+    // levels are distilled K - 1 times like SumK's vector before the plain sum
+    constexpr auto result() const
+    {
+        std::array<V, K> p;
+        p[0] = c;
+        for (size_t j = 0; j < K - 1; j++)
+            p[K - 1 - j] = s[j];
+        for (size_t k = 1; k < K; k++)
+            for (size_t i = 1; i < K; i++) {
+                const auto e = dekker_add12(p[i], p[i - 1]);
+                p[i] = e.h;
+                p[i - 1] = e.l;
+            }
+        auto result = p[0];
+        for (size_t i = 1; i < K; i++)
+            result = result + p[i];
+        return result;
+    }
+
+    std::array<V, K - 1> s{};
+    V c{};
+};
+
+// folds the lanes of a packed accumulator into a scalar one
+template<size_t K, size_t W>
+auto reduce_add(const compensated_sum<K, simd::pack<double, W>>& a)
+{
+    compensated_sum<K> result;
+    std::array<double, W> lanes;
+    for (size_t j = 0; j < K - 1; j++) {
+        a.s[j].store(lanes.data());
+        for (const auto& x : lanes)
+            result.add(x, j);
+    }
+    a.c.store(lanes.data());
+    for (const auto& x : lanes)
+        result.c += x;
+    return result;
+}
+
+template<size_t W, compensated_scalar T>
+auto load_widened(const T* p)
+{
+    if constexpr (std::is_same_v<T, double>)
+        return simd::pack<double, W>::load(p);
+    else {
+        std::array<double, W> a;
+        for (size_t i = 0; i < W; i++)
+            a[i] = double(p[i]);
+        return simd::pack<double, W>(a);
+    }
+}
+
+template<size_t K, compensated_scalar T>
+auto sumk_range(std::span<const T> a)
+{
+    constexpr auto W = compensated_width;
+    compensated_sum<K> result;
+    size_t i = 0;
+    if constexpr (W > 1) {
+        compensated_sum<K, simd::pack<double, W>> lanes;
+        for (; i + W <= a.size(); i += W)
+            lanes.add(load_widened<W>(&a[i]));
+        result = reduce_add(lanes);
+    }
+    for (; i < a.size(); i++)
+        result.add(double(a[i]));
+    return result;
+}
+
+template<size_t K, compensated_scalar T>
+auto dotk_range(std::span<const T> a, std::span<const T> b)
+{
+    constexpr auto W = compensated_width;
+    compensated_sum<K> result;
+    size_t i = 0;
+    if constexpr (W > 1) {
+        compensated_sum<K, simd::pack<double, W>> lanes;
+        for (; i + W <= a.size(); i += W)
+            lanes.add_product(load_widened<W>(&a[i]), load_widened<W>(&b[i]));
+        result = reduce_add(lanes);
+    }
+    for (; i < a.size(); i++)
+        result.add_product(double(a[i]), double(b[i]));
+    return result;
+}
+
+// ranges reduced on the thread pool and merged in order, so a given thread
+// count always gives the same result. Short spans return before the pool
+// is touched, next to it gcc keeps the accumulator in memory
+template<size_t K, typename F>
+auto compensated_reduce(size_t count, F&& f)
+{
+    if (count < compensated_parallel_threshold || thread_pool::global().size() == 1)
+        return f(0, count).result();
+    const auto result = parallel_reduce(
+      count, compensated_parallel_threshold / 4, compensated_sum<K>(),
+      [&](size_t first, size_t last) { return f(first, last - first); },
+      [](compensated_sum<K> a, const compensated_sum<K>& b) {
+          a.merge(b);
+          return a;
+      });
+    return result.result();
+}
+
+template<size_t K, compensated_scalar T>
+auto sumk(std::span<const T> a)
+{
+    const auto result = compensated_reduce<K>(a.size(), [&](size_t first, size_t n) {
+        return sumk_range<K>(a.subspan(first, std::min(n, a.size() - first)));
+    });
+    return T(result);
+}
+
+// over the shorter of the two spans
+template<size_t K, compensated_scalar T>
+auto dotk(std::span<const T> a, std::span<const T> b)
+{
+    const auto count = std::min(a.size(), b.size());
+    const auto result = compensated_reduce<K>(count, [&](size_t first, size_t n) {
+        n = std::min(n, count - first);
+        return dotk_range<K>(a.subspan(first, n), b.subspan(first, n));
+    });
+    return T(result);
+}
+
+template<compensated_scalar T>
+auto sum2(std::span<const T> a)
+{
+    return sumk<2>(a);
+}
+
+template<compensated_scalar T>
+auto dot2(std::span<const T> a, std::span<const T> b)
+{
+    return dotk<2>(a, b);
+}
+
+template<size_t K, compensated_scalar T, size_t N>
+auto sumk(const vector<T, N>& a)
+{
+    compensated_sum<K> acc;
+    for (size_t i = 0; i < N; i++)
+        acc.add(double(a[i]));
+    const auto result = T(acc.result());
+    return result;
+}
+
+template<size_t K, compensated_scalar T, size_t N>
+auto dotk(const vector<T, N>& a, const vector<T, N>& b)
+{
+    compensated_sum<K> acc;
+    for (size_t i = 0; i < N; i++)
+        acc.add_product(double(a[i]), double(b[i]));
+    const auto result = T(acc.result());
+    return result;
+}
+
+template<compensated_scalar T, size_t N>
+auto sum2(const vector<T, N>& a)
+{
+    return sumk<2>(a);
+}
+
+template<compensated_scalar T, size_t N>
+auto dot2(const vector<T, N>& a, const vector<T, N>& b)
+{
+    return dotk<2>(a, b);
+}
+
+} // namespace math
+
+#endif /* SUMMATION_MATH_H */
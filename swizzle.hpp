@@ -24,353 +24,421 @@
 #define SWIZZLE_H
 
 #include "vector.hpp"
+#include <algorithm>
+#include <array>
+#include <type_traits>
 
 namespace math {
 
-template<typename T, math_vector U>
+template<size_t I, typename V>
+constexpr auto& component(V& v)
+{
+    static_assert(I < 4);
+    if constexpr (I == 0)
+        return v.x;
+    else if constexpr (I == 1)
+        return v.y;
+    else if constexpr (I == 2)
+        return v.z;
+    else
+        return v.w;
+}
+
+// a swizzle is the pack of its source components, x y z w are 0 1 2 3, and
+// reads any vector that has all of them. four lane permutes of simd backed
+// vectors are one shuffle of the register
+template<size_t... I>
+struct swizzle_indices {
+    static constexpr size_t size = sizeof...(I);
+    static constexpr size_t extent = std::max({ I... }) + 1;
+
+    template<math_scalar T, size_t N>
+        requires(N >= 2 && N <= 4 && extent <= N)
+    constexpr auto operator()(const vector<T, N>& v) const
+    {
+#if defined(LUCMATH_SIMD)
+        if constexpr (N == 4 && size == 4 && simd_backed<T, 4>) {
+            if (!std::is_constant_evaluated()) {
+                const auto result = simd_store<4>(simd_load(v).template shuffle<I...>());
+                return result;
+            }
+        }
+#endif
+        const vector<T, size> result(component<I>(v)...);
+        return result;
+    }
+
+    // component J of u goes to component I_J of v, a component may only be
+    // written once
+    template<math_scalar T, size_t N>
+        requires(N >= 2 && N <= 4 && extent <= N)
+    static constexpr auto assign(vector<T, N>& v, const vector<T, size>& u)
+    {
+        constexpr std::array<size_t, size> indices{ I... };
+        static_assert([&] {
+            for (size_t a = 0; a < size; a++)
+                for (size_t b = a + 1; b < size; b++)
+                    if (indices[a] == indices[b])
+                        return false;
+            return true;
+        }(), "swizzle_assign writes a component twice");
+        [&]<size_t... J>(std::index_sequence<J...>) {
+            ((component<I>(v) = component<J>(u)), ...);
+        }(std::make_index_sequence<size>{});
+    }
+};
+
+template<typename S, math_vector U>
+constexpr auto swizzle(const U& v)
+{
+    const auto result = S{}(v);
+    return result;
+}
+
+template<size_t... I, math_vector U>
 constexpr auto swizzle(const U& v)
 {
-    const auto result = T{}(v);
+    const auto result = swizzle_indices<I...>{}(v);
     return result;
 }
 
-struct WW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.w,v.w);}};
-struct WWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.w,v.w);}};
-struct WWWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.w,v.w);}};
-struct WWWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.w,v.x);}};
-struct WWWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.w,v.y);}};
-struct WWWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.w,v.z);}};
-struct WWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.w,v.x);}};
-struct WWXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.x,v.w);}};
-struct WWXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.x,v.x);}};
-struct WWXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.x,v.y);}};
-struct WWXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.x,v.z);}};
-struct WWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.w,v.y);}};
-struct WWYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.y,v.w);}};
-struct WWYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.y,v.x);}};
-struct WWYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.y,v.y);}};
-struct WWYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.y,v.z);}};
-struct WWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.w,v.z);}};
-struct WWZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.z,v.w);}};
-struct WWZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.z,v.x);}};
-struct WWZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.z,v.y);}};
-struct WWZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.w,v.z,v.z);}};
-struct WX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.w,v.x);}};
-struct WXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.x,v.w);}};
-struct WXWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.w,v.w);}};
-struct WXWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.w,v.x);}};
-struct WXWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.w,v.y);}};
-struct WXWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.w,v.z);}};
-struct WXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.x,v.x);}};
-struct WXXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.x,v.w);}};
-struct WXXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.x,v.x);}};
-struct WXXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.x,v.y);}};
-struct WXXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.x,v.z);}};
-struct WXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.x,v.y);}};
-struct WXYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.y,v.w);}};
-struct WXYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.y,v.x);}};
-struct WXYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.y,v.y);}};
-struct WXYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.y,v.z);}};
-struct WXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.x,v.z);}};
-struct WXZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.z,v.w);}};
-struct WXZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.z,v.x);}};
-struct WXZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.z,v.y);}};
-struct WXZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.x,v.z,v.z);}};
-struct WY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.w,v.y);}};
-struct WYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.y,v.w);}};
-struct WYWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.w,v.w);}};
-struct WYWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.w,v.x);}};
-struct WYWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.w,v.y);}};
-struct WYWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.w,v.z);}};
-struct WYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.y,v.x);}};
-struct WYXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.x,v.w);}};
-struct WYXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.x,v.x);}};
-struct WYXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.x,v.y);}};
-struct WYXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.x,v.z);}};
-struct WYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.y,v.y);}};
-struct WYYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.y,v.w);}};
-struct WYYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.y,v.x);}};
-struct WYYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.y,v.y);}};
-struct WYYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.y,v.z);}};
-struct WYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.y,v.z);}};
-struct WYZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.z,v.w);}};
-struct WYZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.z,v.x);}};
-struct WYZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.z,v.y);}};
-struct WYZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.y,v.z,v.z);}};
-struct WZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.w,v.z);}};
-struct WZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.z,v.w);}};
-struct WZWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.w,v.w);}};
-struct WZWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.w,v.x);}};
-struct WZWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.w,v.y);}};
-struct WZWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.w,v.z);}};
-struct WZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.z,v.x);}};
-struct WZXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.x,v.w);}};
-struct WZXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.x,v.x);}};
-struct WZXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.x,v.y);}};
-struct WZXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.x,v.z);}};
-struct WZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.z,v.y);}};
-struct WZYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.y,v.w);}};
-struct WZYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.y,v.x);}};
-struct WZYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.y,v.y);}};
-struct WZYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.y,v.z);}};
-struct WZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.w,v.z,v.z);}};
-struct WZZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.z,v.w);}};
-struct WZZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.z,v.x);}};
-struct WZZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.z,v.y);}};
-struct WZZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.w,v.z,v.z,v.z);}};
-struct XW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.x,v.w);}};
-struct XWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.w,v.w);}};
-struct XWWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.w,v.w);}};
-struct XWWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.w,v.x);}};
-struct XWWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.w,v.y);}};
-struct XWWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.w,v.z);}};
-struct XWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.w,v.x);}};
-struct XWXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.x,v.w);}};
-struct XWXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.x,v.x);}};
-struct XWXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.x,v.y);}};
-struct XWXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.x,v.z);}};
-struct XWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.w,v.y);}};
-struct XWYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.y,v.w);}};
-struct XWYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.y,v.x);}};
-struct XWYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.y,v.y);}};
-struct XWYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.y,v.z);}};
-struct XWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.w,v.z);}};
-struct XWZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.z,v.w);}};
-struct XWZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.z,v.x);}};
-struct XWZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.z,v.y);}};
-struct XWZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.w,v.z,v.z);}};
-struct XXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.x,v.w);}};
-struct XXWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.w,v.w);}};
-struct XXWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.w,v.x);}};
-struct XXWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.w,v.y);}};
-struct XXWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.w,v.z);}};
-struct XXXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.w);}};
-struct XXYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.w);}};
-struct XXZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.w);}};
-struct XYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.y,v.w);}};
-struct XYWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.w,v.w);}};
-struct XYWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.w,v.x);}};
-struct XYWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.w,v.y);}};
-struct XYWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.w,v.z);}};
-struct XYXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.w);}};
-struct XYYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.w);}};
-struct XYZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.w);}};
-struct XZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.z,v.w);}};
-struct XZWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.w,v.w);}};
-struct XZWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.w,v.x);}};
-struct XZWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.w,v.y);}};
-struct XZWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.w,v.z);}};
-struct XZYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.w);}};
-struct XZZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.w);}};
-struct YW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.y,v.w);}};
-struct YWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.w,v.w);}};
-struct YWWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.w,v.w);}};
-struct YWWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.w,v.x);}};
-struct YWWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.w,v.y);}};
-struct YWWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.w,v.z);}};
-struct YWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.w,v.x);}};
-struct YWXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.x,v.w);}};
-struct YWXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.x,v.x);}};
-struct YWXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.x,v.y);}};
-struct YWXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.x,v.z);}};
-struct YWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.w,v.y);}};
-struct YWYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.y,v.w);}};
-struct YWYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.y,v.x);}};
-struct YWYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.y,v.y);}};
-struct YWYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.y,v.z);}};
-struct YWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.w,v.z);}};
-struct YWZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.z,v.w);}};
-struct YWZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.z,v.x);}};
-struct YWZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.z,v.y);}};
-struct YWZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.w,v.z,v.z);}};
-struct YXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.x,v.w);}};
-struct YXWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.w,v.w);}};
-struct YXWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.w,v.x);}};
-struct YXWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.w,v.y);}};
-struct YXWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.w,v.z);}};
-struct YXXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.w);}};
-struct YXYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.w);}};
-struct YXZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.w);}};
-struct YYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.y,v.w);}};
-struct YYWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.w,v.w);}};
-struct YYWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.w,v.x);}};
-struct YYWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.w,v.y);}};
-struct YYWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.w,v.z);}};
-struct YYXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.w);}};
-struct YYYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.w);}};
-struct YYZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.w);}};
-struct YZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.z,v.w);}};
-struct YZWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.w,v.w);}};
-struct YZWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.w,v.x);}};
-struct YZWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.w,v.y);}};
-struct YZWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.w,v.z);}};
-struct YZXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.w);}};
-struct YZYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.w);}};
-struct YZZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.w);}};
-struct ZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.z,v.w);}};
-struct ZWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.w,v.w);}};
-struct ZWWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.w,v.w);}};
-struct ZWWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.w,v.x);}};
-struct ZWWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.w,v.y);}};
-struct ZWWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.w,v.z);}};
-struct ZWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.w,v.x);}};
-struct ZWXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.x,v.w);}};
-struct ZWXX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.x,v.x);}};
-struct ZWXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.x,v.y);}};
-struct ZWXZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.x,v.z);}};
-struct ZWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.w,v.y);}};
-struct ZWYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.y,v.w);}};
-struct ZWYX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.y,v.x);}};
-struct ZWYY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.y,v.y);}};
-struct ZWYZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.y,v.z);}};
-struct ZWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.w,v.z);}};
-struct ZWZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.z,v.w);}};
-struct ZWZX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.z,v.x);}};
-struct ZWZY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.z,v.y);}};
-struct ZWZZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.w,v.z,v.z);}};
-struct ZXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.x,v.w);}};
-struct ZXWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.w,v.w);}};
-struct ZXWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.w,v.x);}};
-struct ZXWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.w,v.y);}};
-struct ZXWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.w,v.z);}};
-struct ZXXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.w);}};
-struct ZXYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.w);}};
-struct ZXZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.w);}};
-struct ZYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.y,v.w);}};
-struct ZYWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.w,v.w);}};
-struct ZYWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.w,v.x);}};
-struct ZYWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.w,v.y);}};
-struct ZYWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.w,v.z);}};
-struct ZYXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.w);}};
-struct ZYYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.w);}};
-struct ZYZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.w);}};
-struct ZZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.z,v.w);}};
-struct ZZWW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.w,v.w);}};
-struct ZZWX {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.w,v.x);}};
-struct ZZWY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.w,v.y);}};
-struct ZZWZ {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.w,v.z);}};
-struct ZZXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.w);}};
-struct ZZYW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.w);}};
-struct ZZZW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.w);}};
-struct XZXW {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.w);}};
-struct XX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 2>(v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.x,v.x);}};
-struct XXX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.x,v.x);}};
-struct XXXX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.x);}};
-struct XXXY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.y);}};
-struct XXXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.x,v.z);}};
-struct XXY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.x,v.y);}};
-struct XXYX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.x);}};
-struct XXYY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.y);}};
-struct XXYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.y,v.z);}};
-struct XXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.x,v.z);}};
-struct XXZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.x);}};
-struct XXZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.y);}};
-struct XXZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.x,v.z,v.z);}};
-struct XY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 2>(v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.x,v.y);}};
-struct XYX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.y,v.x);}};
-struct XYXX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.x);}};
-struct XYXY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.y);}};
-struct XYXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.x,v.z);}};
-struct XYY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.y,v.y);}};
-struct XYYX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.x);}};
-struct XYYY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.y);}};
-struct XYYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.y,v.z);}};
-struct XYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.y,v.z);}};
-struct XYZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.x);}};
-struct XYZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.y);}};
-struct XYZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.y,v.z,v.z);}};
-struct XZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.x,v.z);}};
-struct XZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.z,v.x);}};
-struct XZXX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.x);}};
-struct XZXY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.y);}};
-struct XZXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.x,v.z);}};
-struct XZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.z,v.y);}};
-struct XZYX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.x);}};
-struct XZYY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.y);}};
-struct XZYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.y,v.z);}};
-struct XZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.x,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.x,v.z,v.z);}};
-struct XZZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.x);}};
-struct XZZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.y);}};
-struct XZZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.x,v.z,v.z,v.z);}};
-struct YX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 2>(v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.y,v.x);}};
-struct YXX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.x,v.x);}};
-struct YXXX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.x);}};
-struct YXXY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.y);}};
-struct YXXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.x,v.z);}};
-struct YXY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.y,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.x,v.y);}};
-struct YXYX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.x);}};
-struct YXYY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.y);}};
-struct YXYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.y,v.z);}};
-struct YXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.x,v.z);}};
-struct YXZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.x);}};
-struct YXZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.y);}};
-struct YXZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.x,v.z,v.z);}};
-struct YY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 2>(v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.y,v.y);}};
-struct YYX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.y,v.x);}};
-struct YYXX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.x);}};
-struct YYXY {template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.y);}  template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.y);}};
-struct YYXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.x,v.z);}};
-struct YYY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 3>(v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.y,v.y);}};
-struct YYYX { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.x);}};
-struct YYYY { template<math_scalar T>constexpr auto operator()(const vector<T, 2>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.y);}};
-struct YYYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.y,v.z);}};
-struct YYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.y,v.z);}};
-struct YYZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.x);}};
-struct YYZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.y);}};
-struct YYZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.y,v.z,v.z);}};
-struct YZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.y,v.z);}};
-struct YZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.z,v.x);}};
-struct YZXX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.x);}};
-struct YZXY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.y);}};
-struct YZXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.x,v.z);}};
-struct YZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.z,v.y);}};
-struct YZYX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.x);}};
-struct YZYY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.y);}};
-struct YZYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.y,v.z);}};
-struct YZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.y,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.y,v.z,v.z);}};
-struct YZZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.x);}};
-struct YZZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.y);}};
-struct YZZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.y,v.z,v.z,v.z);}};
-struct ZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.z,v.x);}};
-struct ZXX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.x,v.x);}};
-struct ZXXX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.x);}};
-struct ZXXY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.y);}};
-struct ZXXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.x,v.z);}};
-struct ZXY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.x,v.y);}};
-struct ZXYX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.x);}};
-struct ZXYY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.y);}};
-struct ZXYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.y,v.z);}};
-struct ZXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.x,v.z);}};
-struct ZXZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.x);}};
-struct ZXZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.y);}};
-struct ZXZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.x,v.z,v.z);}};
-struct ZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.z,v.y);}};
-struct ZYX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.y,v.x);}};
-struct ZYXX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.x);}};
-struct ZYXY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.y);}};
-struct ZYXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.x,v.z);}};
-struct ZYY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.y,v.y);}};
-struct ZYYX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.x);}};
-struct ZYYY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.y);}};
-struct ZYYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.y,v.z);}};
-struct ZYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.y,v.z);}};
-struct ZYZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.x);}};
-struct ZYZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.y);}};
-struct ZYZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.y,v.z,v.z);}};
-struct ZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 2>(v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 2>(v.z,v.z);}};
-struct ZZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.z,v.x);}};
-struct ZZXX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.x);}};
-struct ZZXY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.y);}};
-struct ZZXZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.x,v.z);}};
-struct ZZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.z,v.y);}};
-struct ZZYX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.x);}};
-struct ZZYY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.y);}};
-struct ZZYZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.y,v.z);}};
-struct ZZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 3>(v.z,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 3>(v.z,v.z,v.z);}};
-struct ZZZX { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.x);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.x);}};
-struct ZZZY { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.y);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.y);}};
-struct ZZZZ { template<math_scalar T>constexpr auto operator()(const vector<T, 3>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.z);} template<math_scalar T>constexpr auto operator()(const vector<T, 4>& v)const{return vector<T, 4>(v.z,v.z,v.z,v.z);}};
+using WW = swizzle_indices<3, 3>;
+using WWW = swizzle_indices<3, 3, 3>;
+using WWWW = swizzle_indices<3, 3, 3, 3>;
+using WWWX = swizzle_indices<3, 3, 3, 0>;
+using WWWY = swizzle_indices<3, 3, 3, 1>;
+using WWWZ = swizzle_indices<3, 3, 3, 2>;
+using WWX = swizzle_indices<3, 3, 0>;
+using WWXW = swizzle_indices<3, 3, 0, 3>;
+using WWXX = swizzle_indices<3, 3, 0, 0>;
+using WWXY = swizzle_indices<3, 3, 0, 1>;
+using WWXZ = swizzle_indices<3, 3, 0, 2>;
+using WWY = swizzle_indices<3, 3, 1>;
+using WWYW = swizzle_indices<3, 3, 1, 3>;
+using WWYX = swizzle_indices<3, 3, 1, 0>;
+using WWYY = swizzle_indices<3, 3, 1, 1>;
+using WWYZ = swizzle_indices<3, 3, 1, 2>;
+using WWZ = swizzle_indices<3, 3, 2>;
+using WWZW = swizzle_indices<3, 3, 2, 3>;
+using WWZX = swizzle_indices<3, 3, 2, 0>;
+using WWZY = swizzle_indices<3, 3, 2, 1>;
+using WWZZ = swizzle_indices<3, 3, 2, 2>;
+using WX = swizzle_indices<3, 0>;
+using WXW = swizzle_indices<3, 0, 3>;
+using WXWW = swizzle_indices<3, 0, 3, 3>;
+using WXWX = swizzle_indices<3, 0, 3, 0>;
+using WXWY = swizzle_indices<3, 0, 3, 1>;
+using WXWZ = swizzle_indices<3, 0, 3, 2>;
+using WXX = swizzle_indices<3, 0, 0>;
+using WXXW = swizzle_indices<3, 0, 0, 3>;
+using WXXX = swizzle_indices<3, 0, 0, 0>;
+using WXXY = swizzle_indices<3, 0, 0, 1>;
+using WXXZ = swizzle_indices<3, 0, 0, 2>;
+using WXY = swizzle_indices<3, 0, 1>;
+using WXYW = swizzle_indices<3, 0, 1, 3>;
+using WXYX = swizzle_indices<3, 0, 1, 0>;
+using WXYY = swizzle_indices<3, 0, 1, 1>;
+using WXYZ = swizzle_indices<3, 0, 1, 2>;
+using WXZ = swizzle_indices<3, 0, 2>;
+using WXZW = swizzle_indices<3, 0, 2, 3>;
+using WXZX = swizzle_indices<3, 0, 2, 0>;
+using WXZY = swizzle_indices<3, 0, 2, 1>;
+using WXZZ = swizzle_indices<3, 0, 2, 2>;
+using WY = swizzle_indices<3, 1>;
+using WYW = swizzle_indices<3, 1, 3>;
+using WYWW = swizzle_indices<3, 1, 3, 3>;
+using WYWX = swizzle_indices<3, 1, 3, 0>;
+using WYWY = swizzle_indices<3, 1, 3, 1>;
+using WYWZ = swizzle_indices<3, 1, 3, 2>;
+using WYX = swizzle_indices<3, 1, 0>;
+using WYXW = swizzle_indices<3, 1, 0, 3>;
+using WYXX = swizzle_indices<3, 1, 0, 0>;
+using WYXY = swizzle_indices<3, 1, 0, 1>;
+using WYXZ = swizzle_indices<3, 1, 0, 2>;
+using WYY = swizzle_indices<3, 1, 1>;
+using WYYW = swizzle_indices<3, 1, 1, 3>;
+using WYYX = swizzle_indices<3, 1, 1, 0>;
+using WYYY = swizzle_indices<3, 1, 1, 1>;
+using WYYZ = swizzle_indices<3, 1, 1, 2>;
+using WYZ = swizzle_indices<3, 1, 2>;
+using WYZW = swizzle_indices<3, 1, 2, 3>;
+using WYZX = swizzle_indices<3, 1, 2, 0>;
+using WYZY = swizzle_indices<3, 1, 2, 1>;
+using WYZZ = swizzle_indices<3, 1, 2, 2>;
+using WZ = swizzle_indices<3, 2>;
+using WZW = swizzle_indices<3, 2, 3>;
+using WZWW = swizzle_indices<3, 2, 3, 3>;
+using WZWX = swizzle_indices<3, 2, 3, 0>;
+using WZWY = swizzle_indices<3, 2, 3, 1>;
+using WZWZ = swizzle_indices<3, 2, 3, 2>;
+using WZX = swizzle_indices<3, 2, 0>;
+using WZXW = swizzle_indices<3, 2, 0, 3>;
+using WZXX = swizzle_indices<3, 2, 0, 0>;
+using WZXY = swizzle_indices<3, 2, 0, 1>;
+using WZXZ = swizzle_indices<3, 2, 0, 2>;
+using WZY = swizzle_indices<3, 2, 1>;
+using WZYW = swizzle_indices<3, 2, 1, 3>;
+using WZYX = swizzle_indices<3, 2, 1, 0>;
+using WZYY = swizzle_indices<3, 2, 1, 1>;
+using WZYZ = swizzle_indices<3, 2, 1, 2>;
+using WZZ = swizzle_indices<3, 2, 2>;
+using WZZW = swizzle_indices<3, 2, 2, 3>;
+using WZZX = swizzle_indices<3, 2, 2, 0>;
+using WZZY = swizzle_indices<3, 2, 2, 1>;
+using WZZZ = swizzle_indices<3, 2, 2, 2>;
+using XW = swizzle_indices<0, 3>;
+using XWW = swizzle_indices<0, 3, 3>;
+using XWWW = swizzle_indices<0, 3, 3, 3>;
+using XWWX = swizzle_indices<0, 3, 3, 0>;
+using XWWY = swizzle_indices<0, 3, 3, 1>;
+using XWWZ = swizzle_indices<0, 3, 3, 2>;
+using XWX = swizzle_indices<0, 3, 0>;
+using XWXW = swizzle_indices<0, 3, 0, 3>;
+using XWXX = swizzle_indices<0, 3, 0, 0>;
+using XWXY = swizzle_indices<0, 3, 0, 1>;
+using XWXZ = swizzle_indices<0, 3, 0, 2>;
+using XWY = swizzle_indices<0, 3, 1>;
+using XWYW = swizzle_indices<0, 3, 1, 3>;
+using XWYX = swizzle_indices<0, 3, 1, 0>;
+using XWYY = swizzle_indices<0, 3, 1, 1>;
+using XWYZ = swizzle_indices<0, 3, 1, 2>;
+using XWZ = swizzle_indices<0, 3, 2>;
+using XWZW = swizzle_indices<0, 3, 2, 3>;
+using XWZX = swizzle_indices<0, 3, 2, 0>;
+using XWZY = swizzle_indices<0, 3, 2, 1>;
+using XWZZ = swizzle_indices<0, 3, 2, 2>;
+using XX = swizzle_indices<0, 0>;
+using XXW = swizzle_indices<0, 0, 3>;
+using XXWW = swizzle_indices<0, 0, 3, 3>;
+using XXWX = swizzle_indices<0, 0, 3, 0>;
+using XXWY = swizzle_indices<0, 0, 3, 1>;
+using XXWZ = swizzle_indices<0, 0, 3, 2>;
+using XXX = swizzle_indices<0, 0, 0>;
+using XXXW = swizzle_indices<0, 0, 0, 3>;
+using XXXX = swizzle_indices<0, 0, 0, 0>;
+using XXXY = swizzle_indices<0, 0, 0, 1>;
+using XXXZ = swizzle_indices<0, 0, 0, 2>;
+using XXY = swizzle_indices<0, 0, 1>;
+using XXYW = swizzle_indices<0, 0, 1, 3>;
+using XXYX = swizzle_indices<0, 0, 1, 0>;
+using XXYY = swizzle_indices<0, 0, 1, 1>;
+using XXYZ = swizzle_indices<0, 0, 1, 2>;
+using XXZ = swizzle_indices<0, 0, 2>;
+using XXZW = swizzle_indices<0, 0, 2, 3>;
+using XXZX = swizzle_indices<0, 0, 2, 0>;
+using XXZY = swizzle_indices<0, 0, 2, 1>;
+using XXZZ = swizzle_indices<0, 0, 2, 2>;
+using XY = swizzle_indices<0, 1>;
+using XYW = swizzle_indices<0, 1, 3>;
+using XYWW = swizzle_indices<0, 1, 3, 3>;
+using XYWX = swizzle_indices<0, 1, 3, 0>;
+using XYWY = swizzle_indices<0, 1, 3, 1>;
+using XYWZ = swizzle_indices<0, 1, 3, 2>;
+using XYX = swizzle_indices<0, 1, 0>;
+using XYXW = swizzle_indices<0, 1, 0, 3>;
+using XYXX = swizzle_indices<0, 1, 0, 0>;
+using XYXY = swizzle_indices<0, 1, 0, 1>;
+using XYXZ = swizzle_indices<0, 1, 0, 2>;
+using XYY = swizzle_indices<0, 1, 1>;
+using XYYW = swizzle_indices<0, 1, 1, 3>;
+using XYYX = swizzle_indices<0, 1, 1, 0>;
+using XYYY = swizzle_indices<0, 1, 1, 1>;
+using XYYZ = swizzle_indices<0, 1, 1, 2>;
+using XYZ = swizzle_indices<0, 1, 2>;
+using XYZW = swizzle_indices<0, 1, 2, 3>;
+using XYZX = swizzle_indices<0, 1, 2, 0>;
+using XYZY = swizzle_indices<0, 1, 2, 1>;
+using XYZZ = swizzle_indices<0, 1, 2, 2>;
+using XZ = swizzle_indices<0, 2>;
+using XZW = swizzle_indices<0, 2, 3>;
+using XZWW = swizzle_indices<0, 2, 3, 3>;
+using XZWX = swizzle_indices<0, 2, 3, 0>;
+using XZWY = swizzle_indices<0, 2, 3, 1>;
+using XZWZ = swizzle_indices<0, 2, 3, 2>;
+using XZX = swizzle_indices<0, 2, 0>;
+using XZXW = swizzle_indices<0, 2, 0, 3>;
+using XZXX = swizzle_indices<0, 2, 0, 0>;
+using XZXY = swizzle_indices<0, 2, 0, 1>;
+using XZXZ = swizzle_indices<0, 2, 0, 2>;
+using XZY = swizzle_indices<0, 2, 1>;
+using XZYW = swizzle_indices<0, 2, 1, 3>;
+using XZYX = swizzle_indices<0, 2, 1, 0>;
+using XZYY = swizzle_indices<0, 2, 1, 1>;
+using XZYZ = swizzle_indices<0, 2, 1, 2>;
+using XZZ = swizzle_indices<0, 2, 2>;
+using XZZW = swizzle_indices<0, 2, 2, 3>;
+using XZZX = swizzle_indices<0, 2, 2, 0>;
+using XZZY = swizzle_indices<0, 2, 2, 1>;
+using XZZZ = swizzle_indices<0, 2, 2, 2>;
+using YW = swizzle_indices<1, 3>;
+using YWW = swizzle_indices<1, 3, 3>;
+using YWWW = swizzle_indices<1, 3, 3, 3>;
+using YWWX = swizzle_indices<1, 3, 3, 0>;
+using YWWY = swizzle_indices<1, 3, 3, 1>;
+using YWWZ = swizzle_indices<1, 3, 3, 2>;
+using YWX = swizzle_indices<1, 3, 0>;
+using YWXW = swizzle_indices<1, 3, 0, 3>;
+using YWXX = swizzle_indices<1, 3, 0, 0>;
+using YWXY = swizzle_indices<1, 3, 0, 1>;
+using YWXZ = swizzle_indices<1, 3, 0, 2>;
+using YWY = swizzle_indices<1, 3, 1>;
+using YWYW = swizzle_indices<1, 3, 1, 3>;
+using YWYX = swizzle_indices<1, 3, 1, 0>;
+using YWYY = swizzle_indices<1, 3, 1, 1>;
+using YWYZ = swizzle_indices<1, 3, 1, 2>;
+using YWZ = swizzle_indices<1, 3, 2>;
+using YWZW = swizzle_indices<1, 3, 2, 3>;
+using YWZX = swizzle_indices<1, 3, 2, 0>;
+using YWZY = swizzle_indices<1, 3, 2, 1>;
+using YWZZ = swizzle_indices<1, 3, 2, 2>;
+using YX = swizzle_indices<1, 0>;
+using YXW = swizzle_indices<1, 0, 3>;
+using YXWW = swizzle_indices<1, 0, 3, 3>;
+using YXWX = swizzle_indices<1, 0, 3, 0>;
+using YXWY = swizzle_indices<1, 0, 3, 1>;
+using YXWZ = swizzle_indices<1, 0, 3, 2>;
+using YXX = swizzle_indices<1, 0, 0>;
+using YXXW = swizzle_indices<1, 0, 0, 3>;
+using YXXX = swizzle_indices<1, 0, 0, 0>;
+using YXXY = swizzle_indices<1, 0, 0, 1>;
+using YXXZ = swizzle_indices<1, 0, 0, 2>;
+using YXY = swizzle_indices<1, 0, 1>;
+using YXYW = swizzle_indices<1, 0, 1, 3>;
+using YXYX = swizzle_indices<1, 0, 1, 0>;
+using YXYY = swizzle_indices<1, 0, 1, 1>;
+using YXYZ = swizzle_indices<1, 0, 1, 2>;
+using YXZ = swizzle_indices<1, 0, 2>;
+using YXZW = swizzle_indices<1, 0, 2, 3>;
+using YXZX = swizzle_indices<1, 0, 2, 0>;
+using YXZY = swizzle_indices<1, 0, 2, 1>;
+using YXZZ = swizzle_indices<1, 0, 2, 2>;
+using YY = swizzle_indices<1, 1>;
+using YYW = swizzle_indices<1, 1, 3>;
+using YYWW = swizzle_indices<1, 1, 3, 3>;
+using YYWX = swizzle_indices<1, 1, 3, 0>;
+using YYWY = swizzle_indices<1, 1, 3, 1>;
+using YYWZ = swizzle_indices<1, 1, 3, 2>;
+using YYX = swizzle_indices<1, 1, 0>;
+using YYXW = swizzle_indices<1, 1, 0, 3>;
+using YYXX = swizzle_indices<1, 1, 0, 0>;
+using YYXY = swizzle_indices<1, 1, 0, 1>;
+using YYXZ = swizzle_indices<1, 1, 0, 2>;
+using YYY = swizzle_indices<1, 1, 1>;
+using YYYW = swizzle_indices<1, 1, 1, 3>;
+using YYYX = swizzle_indices<1, 1, 1, 0>;
+using YYYY = swizzle_indices<1, 1, 1, 1>;
+using YYYZ = swizzle_indices<1, 1, 1, 2>;
+using YYZ = swizzle_indices<1, 1, 2>;
+using YYZW = swizzle_indices<1, 1, 2, 3>;
+using YYZX = swizzle_indices<1, 1, 2, 0>;
+using YYZY = swizzle_indices<1, 1, 2, 1>;
+using YYZZ = swizzle_indices<1, 1, 2, 2>;
+using YZ = swizzle_indices<1, 2>;
+using YZW = swizzle_indices<1, 2, 3>;
+using YZWW = swizzle_indices<1, 2, 3, 3>;
+using YZWX = swizzle_indices<1, 2, 3, 0>;
+using YZWY = swizzle_indices<1, 2, 3, 1>;
+using YZWZ = swizzle_indices<1, 2, 3, 2>;
+using YZX = swizzle_indices<1, 2, 0>;
+using YZXW = swizzle_indices<1, 2, 0, 3>;
+using YZXX = swizzle_indices<1, 2, 0, 0>;
+using YZXY = swizzle_indices<1, 2, 0, 1>;
+using YZXZ = swizzle_indices<1, 2, 0, 2>;
+using YZY = swizzle_indices<1, 2, 1>;
+using YZYW = swizzle_indices<1, 2, 1, 3>;
+using YZYX = swizzle_indices<1, 2, 1, 0>;
+using YZYY = swizzle_indices<1, 2, 1, 1>;
+using YZYZ = swizzle_indices<1, 2, 1, 2>;
+using YZZ = swizzle_indices<1, 2, 2>;
+using YZZW = swizzle_indices<1, 2, 2, 3>;
+using YZZX = swizzle_indices<1, 2, 2, 0>;
+using YZZY = swizzle_indices<1, 2, 2, 1>;
+using YZZZ = swizzle_indices<1, 2, 2, 2>;
+using ZW = swizzle_indices<2, 3>;
+using ZWW = swizzle_indices<2, 3, 3>;
+using ZWWW = swizzle_indices<2, 3, 3, 3>;
+using ZWWX = swizzle_indices<2, 3, 3, 0>;
+using ZWWY = swizzle_indices<2, 3, 3, 1>;
+using ZWWZ = swizzle_indices<2, 3, 3, 2>;
+using ZWX = swizzle_indices<2, 3, 0>;
+using ZWXW = swizzle_indices<2, 3, 0, 3>;
+using ZWXX = swizzle_indices<2, 3, 0, 0>;
+using ZWXY = swizzle_indices<2, 3, 0, 1>;
+using ZWXZ = swizzle_indices<2, 3, 0, 2>;
+using ZWY = swizzle_indices<2, 3, 1>;
+using ZWYW = swizzle_indices<2, 3, 1, 3>;
+using ZWYX = swizzle_indices<2, 3, 1, 0>;
+using ZWYY = swizzle_indices<2, 3, 1, 1>;
+using ZWYZ = swizzle_indices<2, 3, 1, 2>;
+using ZWZ = swizzle_indices<2, 3, 2>;
+using ZWZW = swizzle_indices<2, 3, 2, 3>;
+using ZWZX = swizzle_indices<2, 3, 2, 0>;
+using ZWZY = swizzle_indices<2, 3, 2, 1>;
+using ZWZZ = swizzle_indices<2, 3, 2, 2>;
+using ZX = swizzle_indices<2, 0>;
+using ZXW = swizzle_indices<2, 0, 3>;
+using ZXWW = swizzle_indices<2, 0, 3, 3>;
+using ZXWX = swizzle_indices<2, 0, 3, 0>;
+using ZXWY = swizzle_indices<2, 0, 3, 1>;
+using ZXWZ = swizzle_indices<2, 0, 3, 2>;
+using ZXX = swizzle_indices<2, 0, 0>;
+using ZXXW = swizzle_indices<2, 0, 0, 3>;
+using ZXXX = swizzle_indices<2, 0, 0, 0>;
+using ZXXY = swizzle_indices<2, 0, 0, 1>;
+using ZXXZ = swizzle_indices<2, 0, 0, 2>;
+using ZXY = swizzle_indices<2, 0, 1>;
+using ZXYW = swizzle_indices<2, 0, 1, 3>;
+using ZXYX = swizzle_indices<2, 0, 1, 0>;
+using ZXYY = swizzle_indices<2, 0, 1, 1>;
+using ZXYZ = swizzle_indices<2, 0, 1, 2>;
+using ZXZ = swizzle_indices<2, 0, 2>;
+using ZXZW = swizzle_indices<2, 0, 2, 3>;
+using ZXZX = swizzle_indices<2, 0, 2, 0>;
+using ZXZY = swizzle_indices<2, 0, 2, 1>;
+using ZXZZ = swizzle_indices<2, 0, 2, 2>;
+using ZY = swizzle_indices<2, 1>;
+using ZYW = swizzle_indices<2, 1, 3>;
+using ZYWW = swizzle_indices<2, 1, 3, 3>;
+using ZYWX = swizzle_indices<2, 1, 3, 0>;
+using ZYWY = swizzle_indices<2, 1, 3, 1>;
+using ZYWZ = swizzle_indices<2, 1, 3, 2>;
+using ZYX = swizzle_indices<2, 1, 0>;
+using ZYXW = swizzle_indices<2, 1, 0, 3>;
+using ZYXX = swizzle_indices<2, 1, 0, 0>;
+using ZYXY = swizzle_indices<2, 1, 0, 1>;
+using ZYXZ = swizzle_indices<2, 1, 0, 2>;
+using ZYY = swizzle_indices<2, 1, 1>;
+using ZYYW = swizzle_indices<2, 1, 1, 3>;
+using ZYYX = swizzle_indices<2, 1, 1, 0>;
+using ZYYY = swizzle_indices<2, 1, 1, 1>;
+using ZYYZ = swizzle_indices<2, 1, 1, 2>;
+using ZYZ = swizzle_indices<2, 1, 2>;
+using ZYZW = swizzle_indices<2, 1, 2, 3>;
+using ZYZX = swizzle_indices<2, 1, 2, 0>;
+using ZYZY = swizzle_indices<2, 1, 2, 1>;
+using ZYZZ = swizzle_indices<2, 1, 2, 2>;
+using ZZ = swizzle_indices<2, 2>;
+using ZZW = swizzle_indices<2, 2, 3>;
+using ZZWW = swizzle_indices<2, 2, 3, 3>;
+using ZZWX = swizzle_indices<2, 2, 3, 0>;
+using ZZWY = swizzle_indices<2, 2, 3, 1>;
+using ZZWZ = swizzle_indices<2, 2, 3, 2>;
+using ZZX = swizzle_indices<2, 2, 0>;
+using ZZXW = swizzle_indices<2, 2, 0, 3>;
+using ZZXX = swizzle_indices<2, 2, 0, 0>;
+using ZZXY = swizzle_indices<2, 2, 0, 1>;
+using ZZXZ = swizzle_indices<2, 2, 0, 2>;
+using ZZY = swizzle_indices<2, 2, 1>;
+using ZZYW = swizzle_indices<2, 2, 1, 3>;
+using ZZYX = swizzle_indices<2, 2, 1, 0>;
+using ZZYY = swizzle_indices<2, 2, 1, 1>;
+using ZZYZ = swizzle_indices<2, 2, 1, 2>;
+using ZZZ = swizzle_indices<2, 2, 2>;
+using ZZZW = swizzle_indices<2, 2, 2, 3>;
+using ZZZX = swizzle_indices<2, 2, 2, 0>;
+using ZZZY = swizzle_indices<2, 2, 2, 1>;
+using ZZZZ = swizzle_indices<2, 2, 2, 2>;
 
 } // namespace math
 
-#endif /* SWIZZLE_H */
\ No newline at end of file
+#endif /* SWIZZLE_H */
@@ -0,0 +1,182 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// cross-checks the two exact products behind dekker_mul12, the fma and the
+// Veltkamp split, and the double-double arithmetic built on them. Exits
+// non-zero on the first kind of mismatch and prints a few of them
+
+#include "dekker.hpp"
+#include "transform.hpp"
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::mt19937_64 engine(1234);
+
+int failures = 0;
+
+auto check(bool ok, const char* what, double a, double b)
+{
+    if (!ok && failures++ < 8)
+        std::printf("%s failed for %a, %a\n", what, a, b);
+}
+
+// signed, spread over exponents where neither the split nor the product
+// overflows or goes subnormal
+auto random_double()
+{
+    std::uniform_real_distribution<double> mantissa(1., 2.);
+    std::uniform_int_distribution<int> exponent(-250, 250);
+    std::bernoulli_distribution sign;
+    const auto result = std::ldexp(mantissa(engine), exponent(engine)) * (sign(engine) ? -1. : 1.);
+    return result;
+}
+
+auto random_dekker()
+{
+    std::uniform_real_distribution<double> low(-.5, .5);
+    const auto h = random_double();
+    const math::dekker result(h, h * low(engine) * std::numeric_limits<double>::epsilon());
+    return result;
+}
+
+// relative distance of a double-double from a reference
+auto error(const math::dekker& d, long double ref)
+{
+    const auto result = std::abs((static_cast<long double>(d.h) + d.l - ref) / ref);
+    return result;
+}
+
+auto same(const math::dekker& a, const math::dekker& b)
+{
+    return a.h == b.h && a.l == b.l;
+}
+
+// the same real number, the high parts of two exact products are within an
+// ulp of each other so their difference is exact, and the low parts must
+// make up for it without a rounding error
+auto same_value(const math::dekker& a, const math::dekker& b)
+{
+    const auto d = a.h - b.h;
+    const auto s = math::dekker_add12(b.l, -a.l);
+    return d == s.h && s.l == 0.;
+}
+
+} // namespace
+
+int main()
+{
+    constexpr size_t count = 100000;
+    constexpr auto W = math::batch_width<double>;
+    // long double is the reference where it has a 64 bit significand or more
+    constexpr auto wide = std::numeric_limits<long double>::digits >= 64;
+    const auto bound = std::ldexp(4.l, -std::numeric_limits<long double>::digits);
+
+    // both products are exact. The fma and lane products round the high part
+    // like a * b and agree to the bit, the scalar split may put an ulp of it
+    // in the low part instead, it agrees in value
+    for (size_t i = 0; i < count; i += W) {
+        std::array<double, W> a, b;
+        for (size_t k = 0; k < W; k++) {
+            a[k] = random_double();
+            b[k] = random_double();
+        }
+        const auto lanes = math::dekker_mul12(math::simd::pack<double, W>(a), math::simd::pack<double, W>(b));
+        for (size_t k = 0; k < W; k++) {
+            const auto split = math::dekker_mul12_split(a[k], b[k]);
+            const auto fma = math::dekker_mul12_fma(a[k], b[k]);
+            check(fma.h == a[k] * b[k], "dekker_mul12_fma high part", a[k], b[k]);
+            check(same_value(split, fma), "dekker_mul12_fma against dekker_mul12_split", a[k], b[k]);
+            check(same_value(split, math::dekker_mul12(a[k], b[k])), "dekker_mul12", a[k], b[k]);
+            check(same(fma, math::dekker(lanes.h[k], lanes.l[k])), "lane dekker_mul12", a[k], b[k]);
+        }
+    }
+
+    // 26 bit factors multiply exactly in a 64 bit significand
+    if constexpr (wide) {
+        std::uniform_int_distribution<int64_t> factor(1, (int64_t(1) << 26) - 1);
+        std::uniform_int_distribution<int> exponent(-60, 60);
+        for (size_t i = 0; i < count; i++) {
+            const auto a = std::ldexp(double(factor(engine)), exponent(engine));
+            const auto b = std::ldexp(double(factor(engine)), exponent(engine));
+            const auto ref = static_cast<long double>(a) * b;
+            check(error(math::dekker_mul12_split(a, b), ref) == 0.l, "dekker_mul12_split exact product", a, b);
+            check(error(math::dekker_mul12_fma(a, b), ref) == 0.l, "dekker_mul12_fma exact product", a, b);
+        }
+    }
+
+    // the double-double results are far closer than long double can tell,
+    // so they agree with it to its last bits, and the span kernels agree
+    // with the scalar functions to well beyond double
+    std::vector<math::dekker> a(count), b(count), product(count), quotient(count);
+    for (size_t i = 0; i < count; i++) {
+        a[i] = random_dekker();
+        b[i] = random_dekker();
+    }
+    math::mul_many(a, b, product);
+    math::div_many(a, b, quotient);
+    for (size_t i = 0; i < count; i++) {
+        const auto x = static_cast<long double>(a[i].h) + a[i].l;
+        const auto y = static_cast<long double>(b[i].h) + b[i].l;
+        const auto mul = math::dekker_multiplication(a[i], b[i]);
+        const auto div = math::dekker_division(a[i], b[i]);
+        if constexpr (wide) {
+            check(error(mul, x * y) <= bound, "dekker_multiplication", a[i].h, b[i].h);
+            check(error(div, x / y) <= bound, "dekker_division", a[i].h, b[i].h);
+        }
+        check(error(product[i], static_cast<long double>(mul.h) + mul.l) <= 0x1p-100l, "mul_many", a[i].h, b[i].h);
+        check(error(quotient[i], static_cast<long double>(div.h) + div.l) <= 0x1p-100l, "div_many", a[i].h, b[i].h);
+    }
+
+    // vectors of dekkers flatten into the same componentwise kernels
+    std::vector<math::vector<math::dekker, 3>> a3(count / 3), b3(count / 3), product3(count / 3), quotient3(count / 3);
+    for (size_t i = 0; i < a3.size() * 3; i++) {
+        a3[i / 3][i % 3] = a[i];
+        b3[i / 3][i % 3] = b[i];
+    }
+    math::mul_many<3>(a3, b3, product3);
+    math::div_many<3>(a3, b3, quotient3);
+    for (size_t i = 0; i < a3.size() * 3; i++) {
+        check(error(product3[i / 3][i % 3], static_cast<long double>(product[i].h) + product[i].l) <= 0x1p-100l, "mul_many<3>", a[i].h, b[i].h);
+        check(error(quotient3[i / 3][i % 3], static_cast<long double>(quotient[i].h) + quotient[i].l) <= 0x1p-100l, "div_many<3>", a[i].h, b[i].h);
+    }
+
+    std::printf("dekker_test: %d failures, %s lanes of %zu, fma %s\n", failures,
+#if defined(LUCMATH_SIMD)
+                "simd",
+#else
+                "scalar",
+#endif
+                W,
+#if defined(FP_FAST_FMA)
+                "on"
+#else
+                "off"
+#endif
+    );
+    return failures == 0 ? 0 : 1;
+}
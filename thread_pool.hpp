@@ -0,0 +1,266 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef THREAD_POOL_MATH_H
+#define THREAD_POOL_MATH_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace math {
+
+// a fork-join pool for span kernels. run() hands every participant, the
+// workers and the calling thread, an even share of the chunks. A
+// participant takes chunks from the front of its own range and when that
+// is empty steals the back half of another range, so cores that run ahead
+// or were interrupted even out without a shared queue
+class thread_pool {
+  public:
+    explicit thread_pool(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) :
+      ranges(std::max(1u, threads))
+    {
+        for (unsigned i = 1; i < ranges.size(); i++)
+            workers.emplace_back([this, i] { work(i); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    // the workers and the calling thread
+    auto size() const
+    {
+        return ranges.size();
+    }
+
+    // calls f(chunk) for every chunk in [0, chunks) and returns when all of
+    // them are done, rethrowing the first exception. Calls from inside a
+    // chunk, or while another thread runs the pool, run in place in order
+    template<typename F>
+    auto run(size_t chunks, F&& f)
+    {
+        std::unique_lock<std::mutex> caller(running, std::try_to_lock);
+        if (!caller || inside || workers.empty() || chunks < 2) {
+            for (size_t c = 0; c < chunks; c++)
+                f(c);
+            return;
+        }
+        const auto participants = ranges.size();
+        for (size_t p = 0; p < participants; p++)
+            ranges[p].value.store(pack(chunks * p / participants, chunks * (p + 1) / participants), std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = [](void* context, size_t c) { (*static_cast<std::remove_reference_t<F>*>(context))(c); };
+            context = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+            error = nullptr;
+            pending = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        participate(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // shared by the parallel kernels, sized to the hardware threads
+    static auto& global()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+  private:
+    // begin in the high and end in the low half, so one compare exchange
+    // moves either end
+    static uint64_t pack(uint64_t begin, uint64_t end)
+    {
+        return begin << 32 | end;
+    }
+
+    size_t pop(size_t p)
+    {
+        auto& range = ranges[p].value;
+        auto r = range.load(std::memory_order_relaxed);
+        while ((r >> 32) < (r & 0xffffffff))
+            if (range.compare_exchange_weak(r, r + (uint64_t(1) << 32), std::memory_order_acquire, std::memory_order_relaxed))
+                return size_t(r >> 32);
+        return ~size_t(0);
+    }
+
+    // takes the back half of a victim range, runs its first chunk next and
+    // keeps the rest in the own range where it can be stolen again
+    size_t steal(size_t p)
+    {
+        for (size_t i = 1; i < ranges.size(); i++) {
+            auto& range = ranges[(p + i) % ranges.size()].value;
+            auto r = range.load(std::memory_order_relaxed);
+            while ((r >> 32) < (r & 0xffffffff)) {
+                const auto begin = r >> 32;
+                const auto end = r & 0xffffffff;
+                const auto split = end - (end - begin + 1) / 2;
+                if (range.compare_exchange_weak(r, pack(begin, split), std::memory_order_acquire, std::memory_order_relaxed)) {
+                    ranges[p].value.store(pack(split + 1, end), std::memory_order_release);
+                    return size_t(split);
+                }
+            }
+        }
+        return ~size_t(0);
+    }
+
+    void participate(size_t p)
+    {
+        inside = true;
+        for (;;) {
+            auto c = pop(p);
+            if (c == ~size_t(0))
+                c = steal(p);
+            if (c == ~size_t(0))
+                break;
+            try {
+                job(context, c);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+        inside = false;
+    }
+
+    void work(size_t p)
+    {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stop || generation != seen; });
+                if (stop)
+                    return;
+                seen = generation;
+            }
+            participate(p);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0)
+                done.notify_one();
+        }
+    }
+
+    // one cache line per range so stealing does not bounce the owners
+    struct alignas(64) range {
+        std::atomic<uint64_t> value{ 0 };
+    };
+
+    std::vector<range> ranges;
+    std::vector<std::thread> workers;
+    std::mutex running;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    void (*job)(void*, size_t) = nullptr;
+    void* context = nullptr;
+    std::exception_ptr error;
+    size_t pending = 0;
+    uint64_t generation = 0;
+    bool stop = false;
+    static inline thread_local bool inside = false;
+};
+
+// outputs are split at a whole number of cache lines so two chunks never
+// write the same line of a line aligned span. float3 is 12 bytes, the
+// smallest such run is lcm(64, 12) = 192 bytes or 16 items
+inline constexpr size_t cache_line = 64;
+
+template<typename T>
+inline constexpr size_t cache_line_items = std::lcm(cache_line, sizeof(T)) / sizeof(T);
+
+// about this many chunks per thread, enough for stealing to even out
+// uneven cores without paying for tiny chunks
+inline constexpr size_t chunks_per_thread = 8;
+
+// calls f(first, last) over consecutive ranges of [0, count) on the global
+// pool. A range holds a multiple of grain items, spans of up to grain
+// items run in place before the pool is touched
+template<typename F>
+auto parallel_for(size_t count, size_t grain, F&& f)
+{
+    grain = std::max(grain, size_t(1));
+    if (count <= grain) {
+        f(size_t(0), count);
+        return;
+    }
+    auto& pool = thread_pool::global();
+    const auto target = (count + pool.size() * chunks_per_thread - 1) / (pool.size() * chunks_per_thread);
+    const auto step = (target + grain - 1) / grain * grain;
+    const auto chunks = (count + step - 1) / step;
+    pool.run(chunks, [&](size_t c) { f(c * step, std::min(count, (c + 1) * step)); });
+}
+
+// f(first, last) maps a range to a partial result that starts from
+// identity, the partials are folded with reduce in range order. A single
+// range is returned as is, so an empty count gives f(0, 0) and never
+// reduces identity with itself. The ranges only depend on count, grain and
+// the pool size, so a given thread count always gives the same result
+template<typename T, typename F, typename R>
+auto parallel_reduce(size_t count, size_t grain, const T& identity, F&& f, R&& reduce)
+{
+    grain = std::max(grain, size_t(1));
+    if (count <= grain) {
+        const T result = f(size_t(0), count);
+        return result;
+    }
+    auto& pool = thread_pool::global();
+    const auto target = (count + pool.size() * chunks_per_thread - 1) / (pool.size() * chunks_per_thread);
+    const auto step = (target + grain - 1) / grain * grain;
+    const auto chunks = (count + step - 1) / step;
+    std::vector<T> partial(chunks, identity);
+    pool.run(chunks, [&](size_t c) { partial[c] = f(c * step, std::min(count, (c + 1) * step)); });
+    T result = identity;
+    for (const auto& p : partial)
+        result = reduce(result, p);
+    return result;
+}
+
+} // namespace math
+
+#endif /* THREAD_POOL_MATH_H */
@@ -0,0 +1,572 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef TRANSFORM_MATH_H
+#define TRANSFORM_MATH_H
+
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "affine.hpp"
+#include "dekker.hpp"
+#include "quaternion.hpp"
+#include "fast.hpp"
+#include "simd.hpp"
+#include "vector_soa.hpp"
+#include <algorithm>
+#include <span>
+#include <type_traits>
+
+namespace math {
+
+// batch kernels broadcast the matrix elements into registers once and then
+// stream the span through vector_soa packets of batch_width lanes, output
+// may alias input, only min(in.size(), out.size()) elements are written
+
+// without intrinsics a packet is an array loop, single lanes leave the
+// per-element loop to the auto-vectorizer instead
+#if defined(LUCMATH_SIMD)
+template<typename T>
+inline constexpr size_t batch_width = simd::native_width<T>;
+#else
+template<typename T>
+inline constexpr size_t batch_width = 1;
+#endif
+
+template<typename T, size_t N>
+using span_in = std::type_identity_t<std::span<const vector<T, N>>>;
+
+template<typename T, size_t N>
+using span_out = std::type_identity_t<std::span<vector<T, N>>>;
+
+template<typename T, size_t N>
+using matrix_in = std::type_identity_t<std::span<const matrix<T, N, N>>>;
+
+template<typename T, size_t N>
+using matrix_out = std::type_identity_t<std::span<matrix<T, N, N>>>;
+
+template<typename T>
+using affine_in = std::type_identity_t<std::span<const affine<T>>>;
+
+template<typename T>
+using affine_out = std::type_identity_t<std::span<affine<T>>>;
+
+template<typename T>
+using quaternion_in = std::type_identity_t<std::span<const quaternion<T>>>;
+
+template<typename T>
+using quaternion_out = std::type_identity_t<std::span<quaternion<T>>>;
+
+// quaternions stream through the same packets as four component vectors
+template<typename T>
+auto as_vectors(std::span<const quaternion<T>> q)
+{
+    const std::span<const vector<T, 4>> result(reinterpret_cast<const vector<T, 4>*>(q.data()), q.size());
+    return result;
+}
+
+template<typename T>
+auto as_vectors(std::span<quaternion<T>> q)
+{
+    const std::span<vector<T, 4>> result(reinterpret_cast<vector<T, 4>*>(q.data()), q.size());
+    return result;
+}
+
+template<typename T, size_t R, size_t C>
+auto broadcast(const matrix<T, R, C>& m)
+{
+    using lane = simd::pack<T, batch_width<T>>;
+    std::array<lane, R * C> result;
+    for (size_t i = 0; i < R * C; i++)
+        result[i] = lane(m.values[i]);
+    return result;
+}
+
+// the twelve elements of a 3x4 in column order, position last
+template<typename T>
+auto broadcast(const affine<T>& a)
+{
+    using lane = simd::pack<T, batch_width<T>>;
+    std::array<lane, 12> result;
+    for (size_t i = 0; i < 9; i++)
+        result[i] = lane(a.orientation.values[i]);
+    for (size_t i = 0; i < 3; i++)
+        result[9 + i] = lane(a.position[i]);
+    return result;
+}
+
+template<typename T>
+auto transform_points(const matrix<T, 4, 4>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto e = broadcast(m);
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto p = vector_soa<T, 3, W>::load(in.subspan(i, n));
+        const auto x = simd::fmadd(e[8], p[2], simd::fmadd(e[4], p[1], simd::fmadd(e[0], p[0], e[12])));
+        const auto y = simd::fmadd(e[9], p[2], simd::fmadd(e[5], p[1], simd::fmadd(e[1], p[0], e[13])));
+        const auto z = simd::fmadd(e[10], p[2], simd::fmadd(e[6], p[1], simd::fmadd(e[2], p[0], e[14])));
+        const auto w = simd::fmadd(e[11], p[2], simd::fmadd(e[7], p[1], simd::fmadd(e[3], p[0], e[15])));
+        const vector_soa<T, 3, W> result({ x / w, y / w, z / w });
+        result.store(out.subspan(i, n));
+    }
+}
+
+template<typename T>
+auto transform_points(const matrix<T, 4, 4>& m, span_in<T, 4> in, span_out<T, 4> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto e = broadcast(m);
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto p = vector_soa<T, 4, W>::load(in.subspan(i, n));
+        const auto x = simd::fmadd(e[12], p[3], simd::fmadd(e[8], p[2], simd::fmadd(e[4], p[1], e[0] * p[0])));
+        const auto y = simd::fmadd(e[13], p[3], simd::fmadd(e[9], p[2], simd::fmadd(e[5], p[1], e[1] * p[0])));
+        const auto z = simd::fmadd(e[14], p[3], simd::fmadd(e[10], p[2], simd::fmadd(e[6], p[1], e[2] * p[0])));
+        const auto w = simd::fmadd(e[15], p[3], simd::fmadd(e[11], p[2], simd::fmadd(e[7], p[1], e[3] * p[0])));
+        const vector_soa<T, 4, W> result({ x, y, z, w });
+        result.store(out.subspan(i, n));
+    }
+}
+
+template<typename T>
+auto transform_vectors(const matrix<T, 4, 4>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto e = broadcast(m);
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto v = vector_soa<T, 3, W>::load(in.subspan(i, n));
+        const auto x = simd::fmadd(e[8], v[2], simd::fmadd(e[4], v[1], e[0] * v[0]));
+        const auto y = simd::fmadd(e[9], v[2], simd::fmadd(e[5], v[1], e[1] * v[0]));
+        const auto z = simd::fmadd(e[10], v[2], simd::fmadd(e[6], v[1], e[2] * v[0]));
+        const vector_soa<T, 3, W> result({ x, y, z });
+        result.store(out.subspan(i, n));
+    }
+}
+
+template<typename T>
+auto transform_vectors(const matrix<T, 3, 3>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto e = broadcast(m);
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto v = vector_soa<T, 3, W>::load(in.subspan(i, n));
+        const auto x = simd::fmadd(e[6], v[2], simd::fmadd(e[3], v[1], e[0] * v[0]));
+        const auto y = simd::fmadd(e[7], v[2], simd::fmadd(e[4], v[1], e[1] * v[0]));
+        const auto z = simd::fmadd(e[8], v[2], simd::fmadd(e[5], v[1], e[2] * v[0]));
+        const vector_soa<T, 3, W> result({ x, y, z });
+        result.store(out.subspan(i, n));
+    }
+}
+
+// an affine transform has no projective row, points skip the divide
+template<typename T>
+auto transform_points(const affine<T>& a, span_in<T, 3> in, span_out<T, 3> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto e = broadcast(a);
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto p = vector_soa<T, 3, W>::load(in.subspan(i, n));
+        const auto x = simd::fmadd(e[6], p[2], simd::fmadd(e[3], p[1], simd::fmadd(e[0], p[0], e[9])));
+        const auto y = simd::fmadd(e[7], p[2], simd::fmadd(e[4], p[1], simd::fmadd(e[1], p[0], e[10])));
+        const auto z = simd::fmadd(e[8], p[2], simd::fmadd(e[5], p[1], simd::fmadd(e[2], p[0], e[11])));
+        const vector_soa<T, 3, W> result({ x, y, z });
+        result.store(out.subspan(i, n));
+    }
+}
+
+template<typename T>
+auto transform_vectors(const affine<T>& a, span_in<T, 3> in, span_out<T, 3> out)
+{
+    transform_vectors(a.orientation, in, out);
+}
+
+// two dimensional points in homogeneous coordinates, divided by the third row
+template<typename T>
+auto transform_points(const matrix<T, 3, 3>& m, span_in<T, 2> in, span_out<T, 2> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto e = broadcast(m);
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto p = vector_soa<T, 2, W>::load(in.subspan(i, n));
+        const auto x = simd::fmadd(e[3], p[1], simd::fmadd(e[0], p[0], e[6]));
+        const auto y = simd::fmadd(e[4], p[1], simd::fmadd(e[1], p[0], e[7]));
+        const auto w = simd::fmadd(e[5], p[1], simd::fmadd(e[2], p[0], e[8]));
+        const vector_soa<T, 2, W> result({ x / w, y / w });
+        result.store(out.subspan(i, n));
+    }
+}
+
+template<typename T>
+auto transform_points(const matrix<T, 3, 3>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    transform_vectors(m, in, out);
+}
+
+// normals go through the inverse transpose of the linear part and are not renormalized
+template<typename T>
+auto transform_normals(const matrix<T, 3, 3>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    const auto n = transpose(inverse(m));
+    transform_vectors(n, in, out);
+}
+
+template<typename T>
+auto transform_normals(const matrix<T, 4, 4>& m, span_in<T, 3> in, span_out<T, 3> out)
+{
+    const matrix<T, 3, 3> linear(vector<T, 3>(m.x.x, m.x.y, m.x.z),
+                                 vector<T, 3>(m.y.x, m.y.y, m.y.z),
+                                 vector<T, 3>(m.z.x, m.z.y, m.z.z));
+    transform_normals(linear, in, out);
+}
+
+// the matrix and quaternion kernels take spans only, so the scalar type is
+// named at the call, mul_many<float>(a, b, out)
+
+// pairwise products out[i] = mul(a[i], b[i]), flattening a hierarchy passes
+// the parent world matrices in a and the local ones in b, each product is
+// the register blocked kernel so a matrix never leaves registers halfway
+template<typename T>
+auto mul_many(matrix_in<T, 4> a, matrix_in<T, 4> b, matrix_out<T, 4> out)
+{
+    const auto count = std::min({ a.size(), b.size(), out.size() });
+    for (size_t i = 0; i < count; i++)
+        out[i] = mul(a[i], b[i]);
+}
+
+template<typename T>
+auto mul_many(matrix_in<T, 3> a, matrix_in<T, 3> b, matrix_out<T, 3> out)
+{
+    const auto count = std::min({ a.size(), b.size(), out.size() });
+    for (size_t i = 0; i < count; i++)
+        out[i] = mul(a[i], b[i]);
+}
+
+// writes through the column kernel directly, a copied result would be read
+// back across the overlapping column stores
+template<typename T>
+auto mul_many(affine_in<T> a, affine_in<T> b, affine_out<T> out)
+{
+    const auto count = std::min({ a.size(), b.size(), out.size() });
+    const auto x = reinterpret_cast<const T*>(a.data());
+    const auto y = reinterpret_cast<const T*>(b.data());
+    const auto z = reinterpret_cast<T*>(out.data());
+    for (size_t i = 0; i < count; i++)
+        mul_affine<3>(x + i * 12, y + i * 12, z + i * 12);
+}
+
+template<typename T>
+auto inverse_many(affine_in<T> in, affine_out<T> out)
+{
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i++)
+        out[i] = inverse(in[i]);
+}
+
+template<typename T>
+auto mul_many(quaternion_in<T> a, quaternion_in<T> b, quaternion_out<T> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto count = std::min({ a.size(), b.size(), out.size() });
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto p = vector_soa<T, 4, W>::load(as_vectors(a.subspan(i, n)));
+        const auto q = vector_soa<T, 4, W>::load(as_vectors(b.subspan(i, n)));
+        const auto x = simd::fmadd(p[0], q[3], simd::fmadd(p[3], q[0], simd::fmadd(p[1], q[2], -(p[2] * q[1]))));
+        const auto y = simd::fmadd(p[1], q[3], simd::fmadd(p[3], q[1], simd::fmadd(p[2], q[0], -(p[0] * q[2]))));
+        const auto z = simd::fmadd(p[2], q[3], simd::fmadd(p[3], q[2], simd::fmadd(p[0], q[1], -(p[1] * q[0]))));
+        const auto w = simd::fmadd(p[3], q[3], -simd::fmadd(p[0], q[0], simd::fmadd(p[1], q[1], p[2] * q[2])));
+        const vector_soa<T, 4, W> result({ x, y, z, w });
+        result.store(as_vectors(out.subspan(i, n)));
+    }
+}
+
+// zero quaternions are left as they are, like normalize
+template<typename T>
+auto normalize_many(quaternion_in<T> in, quaternion_out<T> out)
+{
+    constexpr auto W = batch_width<T>;
+    using lane = simd::pack<T, W>;
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto q = vector_soa<T, 4, W>::load(as_vectors(in.subspan(i, n)));
+        const auto len = simd::sqrt(simd::fmadd(q[3], q[3], simd::fmadd(q[2], q[2], simd::fmadd(q[1], q[1], q[0] * q[0]))));
+        const auto il = lane(T(1)) / simd::select(len == lane(T(0)), lane(T(1)), len);
+        const vector_soa<T, 4, W> result({ q[0] * il, q[1] * il, q[2] * il, q[3] * il });
+        result.store(as_vectors(out.subspan(i, n)));
+    }
+}
+
+// v + 2 u x (u x v + w v) for unit quaternions (u, w), the same rotation as
+// rotate without building the basis
+template<typename T>
+auto rotate_many(quaternion_in<T> q, span_in<T, 3> in, span_out<T, 3> out)
+{
+    constexpr auto W = batch_width<T>;
+    const auto two = simd::pack<T, W>(T(2));
+    const auto count = std::min({ q.size(), in.size(), out.size() });
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto r = vector_soa<T, 4, W>::load(as_vectors(q.subspan(i, n)));
+        const auto v = vector_soa<T, 3, W>::load(in.subspan(i, n));
+        const auto cx = simd::fmadd(r[1], v[2], simd::fmadd(r[3], v[0], -(r[2] * v[1])));
+        const auto cy = simd::fmadd(r[2], v[0], simd::fmadd(r[3], v[1], -(r[0] * v[2])));
+        const auto cz = simd::fmadd(r[0], v[1], simd::fmadd(r[3], v[2], -(r[1] * v[0])));
+        const auto x = simd::fmadd(r[1] * cz - r[2] * cy, two, v[0]);
+        const auto y = simd::fmadd(r[2] * cx - r[0] * cz, two, v[1]);
+        const auto z = simd::fmadd(r[0] * cy - r[1] * cx, two, v[2]);
+        const vector_soa<T, 3, W> result({ x, y, z });
+        result.store(out.subspan(i, n));
+    }
+}
+
+// one rotation for the whole span, the basis is built once and the points
+// stream through transform_vectors
+template<typename T>
+auto rotate_many(const quaternion<T>& q, span_in<T, 3> in, span_out<T, 3> out)
+{
+    transform_vectors(rotation3(q), in, out);
+}
+
+// slerp on packets, the lerp and slerp regimes of slerp are both evaluated
+// and blended per lane, acos and sin are the lane polynomials
+template<typename T, size_t W>
+auto slerp(const simd::pack<T, W>& x, const vector_soa<T, 4, W>& a, const vector_soa<T, 4, W>& b)
+{
+    using lane = simd::pack<T, W>;
+    const auto d = simd::fmadd(a[3], b[3], simd::fmadd(a[2], b[2], simd::fmadd(a[1], b[1], a[0] * b[0])));
+    const auto flip = d < lane(T(0));
+    const auto c = simd::abs(d);
+    std::array<lane, 4> b1, l;
+    for (size_t k = 0; k < 4; k++) {
+        b1[k] = simd::select(flip, -b[k], b[k]);
+        l[k] = simd::fmadd(x, b1[k] - a[k], a[k]);
+    }
+    const auto len = simd::sqrt(simd::fmadd(l[3], l[3], simd::fmadd(l[2], l[2], simd::fmadd(l[1], l[1], l[0] * l[0]))));
+    const auto il = lane(T(1)) / simd::select(len == lane(T(0)), lane(T(1)), len);
+    const auto half_theta = simd::acos(simd::min(c, lane(T(1))));
+    const auto sin_half_theta = simd::sqrt(simd::max(lane(T(1)) - c * c, lane(T(0))));
+    const auto lerp_regime = c > lane(T(0.95));
+    const auto identical = c >= lane(T(1));
+    // the lerp lanes divide by a zero sine here, select drops them again
+    const auto ia = simd::sin((lane(T(1)) - x) * half_theta) / sin_half_theta;
+    const auto ib = simd::sin(x * half_theta) / sin_half_theta;
+    vector_soa<T, 4, W> result;
+    for (size_t k = 0; k < 4; k++) {
+        const auto s = simd::fmadd(a[k], ia, b1[k] * ib);
+        result[k] = simd::select(identical, a[k], simd::select(lerp_regime, l[k] * il, s));
+    }
+    return result;
+}
+
+template<typename T>
+auto slerp_many(std::type_identity_t<std::span<const T>> x, quaternion_in<T> a, quaternion_in<T> b, quaternion_out<T> out)
+{
+    constexpr auto W = batch_width<T>;
+    using lane = simd::pack<T, W>;
+    const auto count = std::min({ x.size(), a.size(), b.size(), out.size() });
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        std::array<T, W> t{};
+        std::copy_n(x.begin() + i, n, t.begin());
+        const auto p = vector_soa<T, 4, W>::load(as_vectors(a.subspan(i, n)));
+        const auto q = vector_soa<T, 4, W>::load(as_vectors(b.subspan(i, n)));
+        slerp(lane(t), p, q).store(as_vectors(out.subspan(i, n)));
+    }
+}
+
+// one blend weight for the whole span, a pose blend
+template<typename T>
+auto slerp_many(const T& x, quaternion_in<T> a, quaternion_in<T> b, quaternion_out<T> out)
+{
+    constexpr auto W = batch_width<T>;
+    using lane = simd::pack<T, W>;
+    const auto count = std::min({ a.size(), b.size(), out.size() });
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto p = vector_soa<T, 4, W>::load(as_vectors(a.subspan(i, n)));
+        const auto q = vector_soa<T, 4, W>::load(as_vectors(b.subspan(i, n)));
+        slerp(lane(x), p, q).store(as_vectors(out.subspan(i, n)));
+    }
+}
+
+// euler triples to quaternions on packets, the same terms as from_euler
+// with one lane sincos per axis
+template<typename T, size_t W>
+inline auto from_euler(const vector_soa<T, 3, W>& e, euler_order order = euler_order::xyz)
+{
+    using lane = simd::pack<T, W>;
+    const auto [axes, parity] = euler_axes<T>(order);
+    const auto [i, j, k] = axes;
+    const auto half = lane(T(.5));
+    const auto p = lane(parity);
+    const auto [si, ci] = fast::sincos(e[i] * half);
+    const auto [sj, cj] = fast::sincos(e[j] * half);
+    const auto [sk, ck] = fast::sincos(e[k] * half);
+    const auto cjck = cj * ck;
+    const auto sjsk = sj * sk;
+    const auto sjck = sj * ck;
+    const auto cjsk = cj * sk;
+    vector_soa<T, 4, W> result;
+    result[i] = simd::fmadd(si, cjck, -(p * ci * sjsk));
+    result[j] = simd::fmadd(ci, sjck, p * si * cjsk);
+    result[k] = simd::fmadd(ci, cjsk, -(p * si * sjck));
+    result[3] = simd::fmadd(ci, cjck, p * si * sjsk);
+    return result;
+}
+
+template<typename T, size_t W>
+inline auto to_euler(const vector_soa<T, 4, W>& q, euler_order order = euler_order::xyz)
+{
+    using lane = simd::pack<T, W>;
+    const auto [axes, parity] = euler_axes<T>(order);
+    const auto [i, j, k] = axes;
+    const auto one = lane(T(1));
+    const auto two = lane(T(2));
+    const auto p = lane(parity);
+    const auto i0 = two * simd::fmadd(q[3], q[i], p * q[j] * q[k]);
+    const auto i1 = simd::fmadd(-two, simd::fmadd(q[i], q[i], q[j] * q[j]), one);
+    const auto j0 = two * simd::fmadd(q[3], q[j], -(p * q[i] * q[k]));
+    const auto k0 = two * simd::fmadd(q[3], q[k], p * q[i] * q[j]);
+    const auto k1 = simd::fmadd(-two, simd::fmadd(q[j], q[j], q[k] * q[k]), one);
+    vector_soa<T, 3, W> result;
+    result[i] = fast::atan2(i0, i1);
+    result[j] = fast::asin(simd::min(one, simd::max(-one, j0)));
+    result[k] = fast::atan2(k0, k1);
+    return result;
+}
+
+// authored euler rotations to quaternions and back, a packet of triples at
+// a time
+template<typename T>
+auto from_euler_many(span_in<T, 3> in, quaternion_out<T> out, euler_order order = euler_order::xyz)
+{
+    constexpr auto W = batch_width<T>;
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto e = vector_soa<T, 3, W>::load(in.subspan(i, n));
+        from_euler(e, order).store(as_vectors(out.subspan(i, n)));
+    }
+}
+
+template<typename T>
+auto to_euler_many(quaternion_in<T> in, span_out<T, 3> out, euler_order order = euler_order::xyz)
+{
+    constexpr auto W = batch_width<T>;
+    const auto count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i += W) {
+        const auto n = std::min(W, count - i);
+        const auto q = vector_soa<T, 4, W>::load(as_vectors(in.subspan(i, n)));
+        to_euler(q, order).store(out.subspan(i, n));
+    }
+}
+
+// double-doubles stream through dekker_soa packets, elementwise over the
+// shortest span. Vectors of dekkers are flattened, dekker3 positions add in
+// one pass over all of their components, mul_many<3>(a, b, out)
+
+template<size_t N>
+auto as_dekkers(std::span<const vector<dekker, N>> v)
+{
+    const std::span<const dekker> result(v.empty() ? nullptr : &v[0][0], v.size() * N);
+    return result;
+}
+
+template<size_t N>
+auto as_dekkers(std::span<vector<dekker, N>> v)
+{
+    const std::span<dekker> result(v.empty() ? nullptr : &v[0][0], v.size() * N);
+    return result;
+}
+
+template<typename F>
+auto dekker_many(std::span<const dekker> a, std::span<const dekker> b, std::span<dekker> out, F&& f)
+{
+    constexpr auto W = batch_width<double>;
+    const auto count = std::min({ a.size(), b.size(), out.size() });
+    size_t i = 0;
+    for (; i + W <= count; i += W)
+        f(dekker_soa<W>::load(&a[i]), dekker_soa<W>::load(&b[i])).store(&out[i]);
+    // the rest runs through single lanes, the same arithmetic without a
+    // partial load that gcc would keep on the stack for the loop above too
+    for (; i < count; i++)
+        f(dekker_soa<1>::load(&a[i]), dekker_soa<1>::load(&b[i])).store(&out[i]);
+}
+
+inline auto add_many(std::span<const dekker> a, std::span<const dekker> b, std::span<dekker> out)
+{
+    dekker_many(a, b, out, [](const auto& x, const auto& y) { return x + y; });
+}
+
+inline auto sub_many(std::span<const dekker> a, std::span<const dekker> b, std::span<dekker> out)
+{
+    dekker_many(a, b, out, [](const auto& x, const auto& y) { return x - y; });
+}
+
+inline auto mul_many(std::span<const dekker> a, std::span<const dekker> b, std::span<dekker> out)
+{
+    dekker_many(a, b, out, [](const auto& x, const auto& y) { return x * y; });
+}
+
+inline auto div_many(std::span<const dekker> a, std::span<const dekker> b, std::span<dekker> out)
+{
+    dekker_many(a, b, out, [](const auto& x, const auto& y) { return x / y; });
+}
+
+template<size_t N>
+auto add_many(span_in<dekker, N> a, span_in<dekker, N> b, span_out<dekker, N> out)
+{
+    add_many(as_dekkers(a), as_dekkers(b), as_dekkers(out));
+}
+
+template<size_t N>
+auto sub_many(span_in<dekker, N> a, span_in<dekker, N> b, span_out<dekker, N> out)
+{
+    sub_many(as_dekkers(a), as_dekkers(b), as_dekkers(out));
+}
+
+template<size_t N>
+auto mul_many(span_in<dekker, N> a, span_in<dekker, N> b, span_out<dekker, N> out)
+{
+    mul_many(as_dekkers(a), as_dekkers(b), as_dekkers(out));
+}
+
+template<size_t N>
+auto div_many(span_in<dekker, N> a, span_in<dekker, N> b, span_out<dekker, N> out)
+{
+    div_many(as_dekkers(a), as_dekkers(b), as_dekkers(out));
+}
+
+} // namespace math
+
+#endif /* TRANSFORM_MATH_H */
@@ -24,13 +24,17 @@
 #define TRIANGLE_MATH_H
 
 #include "vector.hpp"
+#include <array>
 
 namespace math {
 
+template<typename T>
+using triangle = std::array<vector<T, 3>, 3>;
+
 template<typename T>
 auto triangle_center(const vector<T, 3>& a, const vector<T, 3>& b, const vector<T, 3>& c)
 {
-    return (a + b + c) * (1.f / 3.f);
+    return (a + b + c) * (T(1) / T(3));
 }
 
 template<typename T>
@@ -42,13 +46,13 @@ auto triangle_normal(const vector<T, 3>& a, const vector<T, 3>& b, const vector<
 template<typename T>
 auto triangle_area(const vector<T, 3>& a, const vector<T, 3>& b, const vector<T, 3>& c)
 {
-    return length(cross(b - a, c - a)) * .5f;
+    return length(cross(b - a, c - a)) * T(.5);
 }
 
 template<typename T>
 auto triangle_signed_volume(const vector<T, 3>& a, const vector<T, 3>& b, const vector<T, 3>& c)
 {
-    return dot(a, cross(b, c)) * (1.f / 6.f);
+    return dot(a, cross(b, c)) * (T(1) / T(6));
 }
 
 } // namespace math
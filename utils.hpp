@@ -26,6 +26,7 @@
 #include "matrix.hpp"
 #include "vector.hpp"
 #include "quaternion.hpp"
+#include "fast.hpp"
 #include <cmath>
 #include <utility>
 #include <optional>
@@ -34,6 +35,62 @@ namespace math {
 template<typename T, size_t N>
 constexpr auto min(const vector<T, N>& t, const vector<T, N>& u)
 {
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return std::min(t.values[i], u.values[i]); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ std::min(std::get<I>(t.as_array()), std::get<I>(u.as_array()))... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
+}
+
+template<typename T, size_t N>
+constexpr auto max(const vector<T, N>& t, const vector<T, N>& u)
+{
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return std::max(t.values[i], u.values[i]); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ std::max(std::get<I>(t.as_array()), std::get<I>(u.as_array()))... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
+}
+
+template<typename T, size_t N>
+constexpr auto min(const vector<T, N>& t, const T& u)
+{
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return std::min(t.values[i], u); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ std::min(std::get<I>(t.as_array()), u)... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
+}
+
+template<typename T, size_t N>
+constexpr auto max(const vector<T, N>& t, const T& u)
+{
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return std::max(t.values[i], u); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ std::max(std::get<I>(t.as_array()), u)... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
+}
+
+#if defined(LUCMATH_SIMD)
+template<typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto min(const vector<T, N>& t, const vector<T, N>& u)
+{
+    if (!std::is_constant_evaluated())
+        return simd_store<N>(simd::min(simd_load(t), simd_load(u)));
     const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
         return std::array<T, N>{ std::min(std::get<I>(t.as_array()), std::get<I>(u.as_array()))... };
     }(std::make_index_sequence<N>{});
@@ -41,8 +98,11 @@ constexpr auto min(const vector<T, N>& t, const vector<T, N>& u)
 }
 
 template<typename T, size_t N>
+    requires simd_backed<T, N>
 constexpr auto max(const vector<T, N>& t, const vector<T, N>& u)
 {
+    if (!std::is_constant_evaluated())
+        return simd_store<N>(simd::max(simd_load(t), simd_load(u)));
     const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
         return std::array<T, N>{ std::max(std::get<I>(t.as_array()), std::get<I>(u.as_array()))... };
     }(std::make_index_sequence<N>{});
@@ -50,22 +110,19 @@ constexpr auto max(const vector<T, N>& t, const vector<T, N>& u)
 }
 
 template<typename T, size_t N>
+    requires simd_backed<T, N>
 constexpr auto min(const vector<T, N>& t, const T& u)
 {
-    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::array<T, N>{ std::min(std::get<I>(t.as_array()), u)... };
-    }(std::make_index_sequence<N>{});
-    return vector<T, N>(result);
+    return min(t, vector<T, N>(u));
 }
 
 template<typename T, size_t N>
+    requires simd_backed<T, N>
 constexpr auto max(const vector<T, N>& t, const T& u)
 {
-    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::array<T, N>{ std::max(std::get<I>(t.as_array()), u)... };
-    }(std::make_index_sequence<N>{});
-    return vector<T, N>(result);
+    return max(t, vector<T, N>(u));
 }
+#endif
 
 template<typename T, typename U, typename V>
 constexpr auto map(const T& x, const U& in_min, const U& in_max, const V& out_min, const V& out_max)
@@ -115,10 +172,14 @@ constexpr auto sanitize(const T& x)
 template<typename T, size_t N>
 constexpr auto sanitize(const vector<T, N>& v)
 {
-    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::array<T, N>{ sanitize(std::get<I>(v.as_array()))... };
-    }(std::make_index_sequence<N>{});
-    return vector<T, N>(result);
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return sanitize(v.values[i]); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ sanitize(std::get<I>(v.as_array()))... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
 }
 
 template<typename T>
@@ -130,10 +191,14 @@ constexpr auto saturate(const T& x)
 template<typename T, size_t N>
 constexpr auto saturate(const vector<T, N>& v)
 {
-    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::array<T, N>{ saturate(std::get<I>(v.as_array()))... };
-    }(std::make_index_sequence<N>{});
-    return vector<T, N>(result);
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return saturate(v.values[i]); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ saturate(std::get<I>(v.as_array()))... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
 }
 
 template<typename T>
@@ -168,18 +233,19 @@ constexpr auto face_forward(const vector<T, N>& n, const vector<T, N>& v)
     return result;
 }
 
-template<typename T, size_t N>
-constexpr auto rotate_axis_angle(const vector<T, N>& v, const vector<T, N>& axis, const T& angle)
+template<typename T, size_t N, typename P = precise_policy>
+constexpr auto rotate_axis_angle(const vector<T, N>& v, const vector<T, N>& axis, const T& angle, P = {})
 {
     const auto axis_len = length(axis);
     const auto axis_len1 = axis_len == T(0) ? T(1) : axis_len;
     const auto scaled_axis = axis / axis_len1;
 
-    const T a = std::sin(angle * T(.5));
+    const auto [half_sin, half_cos] = P::sincos(angle * T(.5));
+    const T a = half_sin;
     const float3 w = scaled_axis * a;
     const auto wv = cross(w, v);
     const auto v1 = cross(w, wv) * T(2);
-    const auto b = std::cos(angle * T(.5)) * T(2);
+    const auto b = half_cos * T(2);
     const auto v2 = wv * b;
 
     const float3 result = v + v1 + v2;
@@ -187,29 +253,29 @@ constexpr auto rotate_axis_angle(const vector<T, N>& v, const vector<T, N>& axis
     return result;
 }
 
-template<typename T>
-constexpr auto atan2(const vector<T, 2>& v)
+template<typename T, typename P = precise_policy>
+constexpr auto atan2(const vector<T, 2>& v, P = {})
 {
-    const auto result = std::atan2(v.y, v.x);
+    const auto result = P::atan2(v.y, v.x);
     return result;
 }
 
-template<typename T>
-constexpr auto separation_angle(const vector<T, 2>& a, const vector<T, 2>& b)
+template<typename T, typename P = precise_policy>
+constexpr auto separation_angle(const vector<T, 2>& a, const vector<T, 2>& b, P = {})
 {
-    const auto angle_a = atan2(a);
-    const auto angle_b = atan2(b);
+    const auto angle_a = atan2(a, P{});
+    const auto angle_b = atan2(b, P{});
     const auto result = angle_b - angle_a;
     return result;
 }
 
-template<typename T>
-constexpr auto vector_angle(const vector<T, 3>& a, const vector<T, 3>& b)
+template<typename T, typename P = precise_policy>
+constexpr auto vector_angle(const vector<T, 3>& a, const vector<T, 3>& b, P = {})
 {
     const auto c = cross(a, b);
     const auto l = length(c);
     const auto d = dot(a, b);
-    const auto result = std::atan2(l, d);
+    const auto result = P::atan2(l, d);
     return result;
 }
 
@@ -261,19 +327,17 @@ bool any_true(const vector<bool, N>& t)
     return result;
 }
 
+// v + 2 u x (u x v + w v) for unit quaternions (u, w), two crosses instead
+// of the three basis vectors of rotation3
 template<typename T>
 constexpr auto rotate(const vector<T, 3>& v, const quaternion<T>& q)
 {
-    const vector<T, 3> a((q.x * q.x + q.w * q.w - q.y * q.y - q.z * q.z),
-                         (T(2) * q.x * q.y - T(2) * q.w * q.z),
-                         (T(2) * q.x * q.z + T(2) * q.w * q.y));
-    const vector<T, 3> b((T(2) * q.w * q.z + T(2) * q.x * q.y),
-                         (q.w * q.w - q.x * q.x + q.y * q.y - q.z * q.z),
-                         (T(-2) * q.w * q.x + T(2) * q.y * q.z));
-    const vector<T, 3> c((T(-2) * q.w * q.y + T(2) * q.x * q.z),
-                         (T(2) * q.w * q.x + T(2) * q.y * q.z),
-                         (q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z));
-    const vector<T, 3> result(dot(v, a), dot(v, b), dot(v, c));
+    const auto cx = q.y * v.z - q.z * v.y + q.w * v.x;
+    const auto cy = q.z * v.x - q.x * v.z + q.w * v.y;
+    const auto cz = q.x * v.y - q.y * v.x + q.w * v.z;
+    const vector<T, 3> result(v.x + T(2) * (q.y * cz - q.z * cy),
+                              v.y + T(2) * (q.z * cx - q.x * cz),
+                              v.z + T(2) * (q.x * cy - q.y * cx));
     return result;
 }
 
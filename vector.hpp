@@ -29,9 +29,22 @@
 #include <limits>
 #include <cstdint>
 #include <type_traits>
+#include "simd.hpp"
 
 namespace math {
 
+// the lazy nodes of expression.hpp, indexed per component
+template<typename E>
+concept vector_expression = E::lazy && requires(const E& e, size_t i) {
+    typename E::value_type;
+    e[i];
+    e.size();
+};
+
+// swizzle.hpp, the component indices of a swizzle
+template<size_t... I>
+struct swizzle_indices;
+
 template<typename T, size_t N>
 struct vector {
     vector() :
@@ -45,6 +58,25 @@ struct vector {
     constexpr vector(const std::array<T, N>& a) :
       values(a) {}
 
+    // building from or assigning a lazy expression evaluates it in one loop
+    // straight into values, the first element of a span expression
+    template<vector_expression E>
+        requires(E::components == N)
+    constexpr vector(const E& e)
+    {
+        for (size_t i = 0; i < N; i++)
+            values[i] = e[i];
+    }
+
+    template<vector_expression E>
+        requires(E::components == N)
+    constexpr auto& operator=(const E& e)
+    {
+        for (size_t i = 0; i < N; i++)
+            values[i] = e[i];
+        return *this;
+    }
+
     T& operator[](std::size_t i)
     {
         return values[i];
@@ -74,6 +106,19 @@ struct vector<T, 1> {
     constexpr vector(const std::array<T, 1>& a) :
       x(a[0]) {}
 
+    template<vector_expression E>
+        requires(E::components == 1)
+    constexpr vector(const E& e) :
+      x(e[0]) {}
+
+    template<vector_expression E>
+        requires(E::components == 1)
+    constexpr auto& operator=(const E& e)
+    {
+        x = e[0];
+        return *this;
+    }
+
     operator T &()
     {
         return x;
@@ -117,6 +162,20 @@ struct vector<T, 2> {
     constexpr vector(const std::array<T, 2>& a) :
       x(a[0]), y(a[1]) {}
 
+    template<vector_expression E>
+        requires(E::components == 2)
+    constexpr vector(const E& e) :
+      x(e[0]), y(e[1]) {}
+
+    template<vector_expression E>
+        requires(E::components == 2)
+    constexpr auto& operator=(const E& e)
+    {
+        x = e[0];
+        y = e[1];
+        return *this;
+    }
+
     T& operator[](std::size_t i)
     {
         return (&x)[i];
@@ -140,6 +199,27 @@ struct vector<T, 2> {
         return result;
     }
 
+    template<size_t... I>
+    constexpr auto swizzle() const
+    {
+        const auto result = swizzle_indices<I...>{}(*this);
+        return result;
+    }
+
+    template<typename S>
+    constexpr auto& swizzle_assign(const vector<T, S::size>& u)
+    {
+        S::assign(*this, u);
+        return *this;
+    }
+
+    template<size_t... I>
+    constexpr auto& swizzle_assign(const vector<T, sizeof...(I)>& u)
+    {
+        swizzle_indices<I...>::assign(*this, u);
+        return *this;
+    }
+
     T x, y;
 };
 
@@ -163,6 +243,21 @@ struct vector<T, 3> {
     constexpr vector(const std::array<T, 3>& a) :
       x(a[0]), y(a[1]), z(a[2]) {}
 
+    template<vector_expression E>
+        requires(E::components == 3)
+    constexpr vector(const E& e) :
+      x(e[0]), y(e[1]), z(e[2]) {}
+
+    template<vector_expression E>
+        requires(E::components == 3)
+    constexpr auto& operator=(const E& e)
+    {
+        x = e[0];
+        y = e[1];
+        z = e[2];
+        return *this;
+    }
+
     T& operator[](std::size_t i)
     {
         return (&x)[i];
@@ -186,6 +281,27 @@ struct vector<T, 3> {
         return result;
     }
 
+    template<size_t... I>
+    constexpr auto swizzle() const
+    {
+        const auto result = swizzle_indices<I...>{}(*this);
+        return result;
+    }
+
+    template<typename S>
+    constexpr auto& swizzle_assign(const vector<T, S::size>& u)
+    {
+        S::assign(*this, u);
+        return *this;
+    }
+
+    template<size_t... I>
+    constexpr auto& swizzle_assign(const vector<T, sizeof...(I)>& u)
+    {
+        swizzle_indices<I...>::assign(*this, u);
+        return *this;
+    }
+
     T x, y, z;
 };
 
@@ -221,6 +337,22 @@ struct vector<T, 4> {
     constexpr vector(const std::array<T, 4>& a) :
       x(a[0]), y(a[1]), z(a[2]), w(a[3]) {}
 
+    template<vector_expression E>
+        requires(E::components == 4)
+    constexpr vector(const E& e) :
+      x(e[0]), y(e[1]), z(e[2]), w(e[3]) {}
+
+    template<vector_expression E>
+        requires(E::components == 4)
+    constexpr auto& operator=(const E& e)
+    {
+        x = e[0];
+        y = e[1];
+        z = e[2];
+        w = e[3];
+        return *this;
+    }
+
     T& operator[](std::size_t i)
     {
         return (&x)[i];
@@ -244,6 +376,27 @@ struct vector<T, 4> {
         return result;
     }
 
+    template<size_t... I>
+    constexpr auto swizzle() const
+    {
+        const auto result = swizzle_indices<I...>{}(*this);
+        return result;
+    }
+
+    template<typename S>
+    constexpr auto& swizzle_assign(const vector<T, S::size>& u)
+    {
+        S::assign(*this, u);
+        return *this;
+    }
+
+    template<size_t... I>
+    constexpr auto& swizzle_assign(const vector<T, sizeof...(I)>& u)
+    {
+        swizzle_indices<I...>::assign(*this, u);
+        return *this;
+    }
+
     T x, y, z, w;
 };
 
@@ -285,6 +438,39 @@ constexpr auto binary_op(const T& lhs, const std::array<T, N>& rhs)
     return vector<T, N>(result);
 }
 
+// longer vectors are written in a loop over their values, an index_sequence
+// expansion would grow compile time and code with every component
+inline constexpr size_t loop_threshold = 16;
+
+template<typename T, size_t N, typename F>
+constexpr auto loop_op(F&& f)
+{
+    std::array<T, N> result{};
+    simd::apply_n(result.data(), N, f);
+    return vector<T, N>(result);
+}
+
+template<typename Op, math_scalar T, size_t N>
+    requires(N > loop_threshold)
+constexpr auto binary(const vector<T, N>& lhs, const vector<T, N>& rhs)
+{
+    return loop_op<T, N>([&](size_t i) { return T(Op{}(lhs.values[i], rhs.values[i])); });
+}
+
+template<typename Op, math_scalar T, size_t N>
+    requires(N > loop_threshold)
+constexpr auto binary(const vector<T, N>& lhs, const T& rhs)
+{
+    return loop_op<T, N>([&](size_t i) { return T(Op{}(lhs.values[i], rhs)); });
+}
+
+template<typename Op, math_scalar T, size_t N>
+    requires(N > loop_threshold)
+constexpr auto binary(const T& lhs, const vector<T, N>& rhs)
+{
+    return loop_op<T, N>([&](size_t i) { return T(Op{}(lhs, rhs.values[i])); });
+}
+
 template<typename Op, math_vector T, math_vector U>
 constexpr auto binary(const T& lhs, const U& rhs)
 {
@@ -303,6 +489,91 @@ constexpr auto binary(const T& lhs, const U& rhs)
     return binary_op<Op>(lhs, rhs.as_array());
 }
 
+#if defined(LUCMATH_SIMD)
+// element types with a four lane register of intrinsics, the generic
+// pack<double, 4> of an sse target is emulated and slower than scalar code
+#if defined(LUCMATH_SIMD_AVX2) || defined(LUCMATH_SIMD_AVX512)
+template<typename T>
+concept simd_register = std::is_same_v<T, float> || std::is_same_v<T, double>;
+#elif defined(LUCMATH_SIMD_SSE41) || defined(LUCMATH_SIMD_NEON)
+template<typename T>
+concept simd_register = std::is_same_v<T, float>;
+#else
+template<typename T>
+concept simd_register = false;
+#endif
+
+// vectors whose operators run in a register. A three component vector pays a
+// shuffle per operator to keep w zero, its scalar code is faster
+template<typename T, size_t N>
+concept simd_backed = simd_register<T> && N == 4;
+
+// vectors a kernel may load into a register, matrix columns of three
+// components amortize the zero w over a whole product
+template<typename T, size_t N>
+concept simd_loadable = simd_register<T> && (N == 3 || N == 4);
+
+template<typename Op>
+concept simd_lowered = std::is_same_v<Op, std::plus<void>> || std::is_same_v<Op, std::minus<void>> || std::is_same_v<Op, std::multiplies<void>> || std::is_same_v<Op, std::divides<void>>;
+
+// three component vectors travel in a four lane register with a zero w
+template<typename T, size_t N>
+    requires simd_loadable<T, N>
+auto simd_load(const vector<T, N>& v)
+{
+    if constexpr (N == 4)
+        return simd::pack<T, 4>::load(&v.x);
+    else
+        return simd::pack<T, 4>::load3(&v.x);
+}
+
+template<size_t N, typename T>
+    requires simd_loadable<T, N>
+auto simd_store(const simd::pack<T, 4>& p)
+{
+    if constexpr (N == 4) {
+        vector<T, 4> result;
+        p.store(&result.x);
+        return result;
+    }
+    else {
+        vector<T, 3> result;
+        p.store3(&result.x);
+        return result;
+    }
+}
+
+template<typename Op, typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto binary(const vector<T, N>& lhs, const vector<T, N>& rhs)
+{
+    if constexpr (simd_lowered<Op>)
+        if (!std::is_constant_evaluated())
+            return simd_store<N>(Op{}(simd_load(lhs), simd_load(rhs)));
+    return binary_op<Op>(lhs.as_array(), rhs.as_array());
+}
+
+template<typename Op, typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto binary(const vector<T, N>& lhs, const T& rhs)
+{
+    if constexpr (simd_lowered<Op>)
+        if (!std::is_constant_evaluated())
+            return simd_store<N>(Op{}(simd_load(lhs), simd::pack<T, 4>(rhs)));
+    return binary_op<Op>(lhs.as_array(), rhs);
+}
+
+template<typename Op, typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto binary(const T& lhs, const vector<T, N>& rhs)
+{
+    if constexpr (simd_lowered<Op>)
+        if (!std::is_constant_evaluated())
+            return simd_store<N>(Op{}(simd::pack<T, 4>(lhs), simd_load(rhs)));
+    return binary_op<Op>(lhs, rhs.as_array());
+}
+#endif
+
 template<vector_or_scalar T, vector_or_scalar U>
 constexpr auto add(const T& lhs, const U& rhs)
 {
@@ -398,6 +669,13 @@ constexpr auto unary(const T& v)
     return unary_op<Op>(v.as_array());
 }
 
+template<typename Op, math_scalar T, size_t N>
+    requires(N > loop_threshold)
+constexpr auto unary(const vector<T, N>& v)
+{
+    return loop_op<T, N>([&](size_t i) { return T(Op{}(v.values[i])); });
+}
+
 template<math_vector T>
 constexpr auto operator-(const T& v)
 {
@@ -425,6 +703,9 @@ constexpr auto collapse(const vector<T, N>& a)
 template<typename T, size_t N>
 constexpr auto dot(const vector<T, N>& a, const vector<T, N>& b)
 {
+    if constexpr (N > loop_threshold && math_scalar<T>)
+        if (!std::is_constant_evaluated())
+            return simd::dot_n(a.values.data(), b.values.data(), N);
     const auto result = collapse(a * b);
     return result;
 }
@@ -440,6 +721,38 @@ constexpr auto cross(const vector<T, 3>& a, const vector<T, 3>& b)
     return result;
 }
 
+#if defined(LUCMATH_SIMD)
+template<typename Op, typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto unary(const vector<T, N>& v)
+{
+    if constexpr (std::is_same_v<Op, std::negate<void>>)
+        if (!std::is_constant_evaluated())
+            return simd_store<N>(-simd_load(v));
+    return unary_op<Op>(v.as_array());
+}
+
+template<typename Op = std::plus<void>, typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto collapse(const vector<T, N>& a)
+{
+    if constexpr (std::is_same_v<Op, std::plus<void>>)
+        if (!std::is_constant_evaluated())
+            return simd::reduce_add(simd_load(a));
+    return Op{}(Op{}(Op{}(a.x, a.y), a.z), a.w);
+}
+
+template<typename T, size_t N>
+    requires simd_backed<T, N>
+constexpr auto dot(const vector<T, N>& a, const vector<T, N>& b)
+{
+    if (!std::is_constant_evaluated())
+        return simd::reduce_add(simd_load(a) * simd_load(b));
+    const auto result = collapse(binary_op<std::multiplies<void>>(a.as_array(), b.as_array()));
+    return result;
+}
+#endif
+
 template<typename T, size_t N>
 constexpr auto length_squared(const vector<T, N>& a)
 {
@@ -500,10 +813,14 @@ constexpr auto normalized_with_length(const vector<T, N>& a)
 template<math_scalar T, math_scalar U, size_t N>
 constexpr auto cast(const vector<U, N>& v)
 {
-    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::array<T, N>{ T(std::get<I>(v.as_array()))... };
-    }(std::make_index_sequence<N>{});
-    return vector<T, N>(result);
+    if constexpr (N > loop_threshold)
+        return loop_op<T, N>([&](size_t i) { return T(v.values[i]); });
+    else {
+        const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<T, N>{ T(std::get<I>(v.as_array()))... };
+        }(std::make_index_sequence<N>{});
+        return vector<T, N>(result);
+    }
 }
 
 using float2 = vector<float, 2>;
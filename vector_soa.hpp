@@ -0,0 +1,362 @@
+// MIT License
+//
+// Copyright (c) 2024 Robin Lind
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef VECTOR_SOA_MATH_H
+#define VECTOR_SOA_MATH_H
+
+#include "vector.hpp"
+#include "simd.hpp"
+#include <array>
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace math {
+
+// W vectors of N components, stored one register per component
+template<typename T, size_t N, size_t W>
+struct vector_soa {
+    using lane = simd::pack<T, W>;
+
+    vector_soa() = default;
+
+    vector_soa(const T& t)
+    {
+        std::fill(std::begin(values), std::end(values), lane(t));
+    }
+
+    vector_soa(const vector<T, N>& v)
+    {
+        for (size_t c = 0; c < N; c++)
+            values[c] = lane(v[c]);
+    }
+
+    vector_soa(const std::array<lane, N>& a) :
+      values(a) {}
+
+    // gathers up to W vectors, missing lanes are zero
+    static auto load(std::span<const vector<T, N>> src)
+    {
+        vector_soa result;
+        if (src.size() >= W) {
+            result.values = simd::load_interleaved<N, W>(reinterpret_cast<const T*>(src.data()));
+            return result;
+        }
+        std::array<std::array<T, W>, N> lanes{};
+        for (size_t i = 0; i < src.size(); i++)
+            for (size_t c = 0; c < N; c++)
+                lanes[c][i] = src[i][c];
+        for (size_t c = 0; c < N; c++)
+            result.values[c] = lane(lanes[c]);
+        return result;
+    }
+
+    // scatters up to W vectors, stops at the end of dst
+    auto store(std::span<vector<T, N>> dst) const
+    {
+        if (dst.size() >= W) {
+            simd::store_interleaved<N, W>(values, reinterpret_cast<T*>(dst.data()));
+            return;
+        }
+        std::array<std::array<T, W>, N> lanes;
+        for (size_t c = 0; c < N; c++)
+            values[c].store(lanes[c].data());
+        for (size_t i = 0; i < dst.size(); i++)
+            for (size_t c = 0; c < N; c++)
+                dst[i][c] = lanes[c][i];
+    }
+
+    auto extract(size_t i) const
+    {
+        vector<T, N> result;
+        for (size_t c = 0; c < N; c++)
+            result[c] = values[c][i];
+        return result;
+    }
+
+    lane& operator[](std::size_t c)
+    {
+        return values[c];
+    }
+
+    const lane& operator[](std::size_t c) const
+    {
+        return values[c];
+    }
+
+    std::array<lane, N> values;
+};
+
+template<typename U, typename T, size_t W>
+concept soa_operand = std::is_same_v<U, T> || std::is_same_v<U, simd::pack<T, W>>;
+
+template<typename Op, typename T, size_t N, size_t W>
+auto soa_binary(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ Op{}(std::get<I>(lhs.values), std::get<I>(rhs.values))... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<typename Op, typename T, size_t N, size_t W>
+auto soa_binary(const vector_soa<T, N, W>& lhs, const simd::pack<T, W>& rhs)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ Op{}(std::get<I>(lhs.values), rhs)... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<typename Op, typename T, size_t N, size_t W>
+auto soa_binary(const simd::pack<T, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ Op{}(lhs, std::get<I>(rhs.values))... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<typename T, size_t N, size_t W>
+auto add(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = soa_binary<std::plus<void>>(lhs, rhs);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto sub(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = soa_binary<std::minus<void>>(lhs, rhs);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto mul(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = soa_binary<std::multiplies<void>>(lhs, rhs);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto div(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = soa_binary<std::divides<void>>(lhs, rhs);
+    return result;
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto mul(const vector_soa<T, N, W>& lhs, const U& rhs)
+{
+    const auto result = soa_binary<std::multiplies<void>>(lhs, simd::pack<T, W>(rhs));
+    return result;
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto mul(const U& lhs, const vector_soa<T, N, W>& rhs)
+{
+    const auto result = soa_binary<std::multiplies<void>>(simd::pack<T, W>(lhs), rhs);
+    return result;
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto div(const vector_soa<T, N, W>& lhs, const U& rhs)
+{
+    const auto result = soa_binary<std::divides<void>>(lhs, simd::pack<T, W>(rhs));
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto operator+(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    return add(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W>
+auto operator-(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    return sub(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W>
+auto operator*(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    return mul(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W>
+auto operator/(const vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    return div(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto operator*(const vector_soa<T, N, W>& lhs, const U& rhs)
+{
+    return mul(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto operator*(const U& lhs, const vector_soa<T, N, W>& rhs)
+{
+    return mul(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto operator/(const vector_soa<T, N, W>& lhs, const U& rhs)
+{
+    return div(lhs, rhs);
+}
+
+template<typename T, size_t N, size_t W>
+auto operator-(const vector_soa<T, N, W>& v)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ -std::get<I>(v.values)... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<typename T, size_t N, size_t W>
+auto operator+=(vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    lhs = lhs + rhs;
+}
+
+template<typename T, size_t N, size_t W>
+auto operator-=(vector_soa<T, N, W>& lhs, const vector_soa<T, N, W>& rhs)
+{
+    lhs = lhs - rhs;
+}
+
+template<typename T, size_t N, size_t W>
+auto dot(const vector_soa<T, N, W>& a, const vector_soa<T, N, W>& b)
+{
+    auto result = a.values[0] * b.values[0];
+    for (size_t c = 1; c < N; c++)
+        result = result + a.values[c] * b.values[c];
+    return result;
+}
+
+template<typename T, size_t W>
+auto cross(const vector_soa<T, 3, W>& a, const vector_soa<T, 3, W>& b)
+{
+    const vector_soa<T, 3, W> result({ a[1] * b[2] - a[2] * b[1],
+                                       a[2] * b[0] - a[0] * b[2],
+                                       a[0] * b[1] - a[1] * b[0] });
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto length_squared(const vector_soa<T, N, W>& a)
+{
+    const auto result = dot(a, a);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto length(const vector_soa<T, N, W>& a)
+{
+    const auto result = simd::sqrt(length_squared(a));
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto distance(const vector_soa<T, N, W>& a, const vector_soa<T, N, W>& b)
+{
+    const auto result = length(a - b);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto normalize(const vector_soa<T, N, W>& a)
+{
+    const auto result = a / length(a);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto min(const vector_soa<T, N, W>& a, const vector_soa<T, N, W>& b)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ simd::min(std::get<I>(a.values), std::get<I>(b.values))... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<typename T, size_t N, size_t W>
+auto max(const vector_soa<T, N, W>& a, const vector_soa<T, N, W>& b)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ simd::max(std::get<I>(a.values), std::get<I>(b.values))... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<typename T, size_t N, size_t W>
+auto clamp(const vector_soa<T, N, W>& x, const vector_soa<T, N, W>& min, const vector_soa<T, N, W>& max)
+{
+    const auto result = math::min(math::max(x, min), max);
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto saturate(const vector_soa<T, N, W>& x)
+{
+    const auto result = clamp(x, vector_soa<T, N, W>(T(0)), vector_soa<T, N, W>(T(1)));
+    return result;
+}
+
+template<typename T, size_t N, size_t W, soa_operand<T, W> U>
+auto lerp(const U& x, const vector_soa<T, N, W>& a, const vector_soa<T, N, W>& b)
+{
+    const simd::pack<T, W> t(x);
+    const auto result = (simd::pack<T, W>(T(1)) - t) * a + t * b;
+    return result;
+}
+
+template<typename T, size_t N, size_t W>
+auto select(const simd::mask<T, W>& m, const vector_soa<T, N, W>& a, const vector_soa<T, N, W>& b)
+{
+    const auto result = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<simd::pack<T, W>, N>{ simd::select(m, std::get<I>(a.values), std::get<I>(b.values))... };
+    }(std::make_index_sequence<N>{});
+    return vector_soa<T, N, W>(result);
+}
+
+template<size_t W>
+using float2_soa = vector_soa<float, 2, W>;
+template<size_t W>
+using float3_soa = vector_soa<float, 3, W>;
+template<size_t W>
+using float4_soa = vector_soa<float, 4, W>;
+
+template<size_t W>
+using double2_soa = vector_soa<double, 2, W>;
+template<size_t W>
+using double3_soa = vector_soa<double, 3, W>;
+template<size_t W>
+using double4_soa = vector_soa<double, 4, W>;
+
+} // namespace math
+
+#endif /* VECTOR_SOA_MATH_H */